@@ -1,252 +1,1474 @@
-/******************************************************************************
- *
- * Module: NVIC
- *
- * File Name: NVIC.c
- *
- * Description: Source file for the ARM Cortex M4 NVIC driver
- *
- * Author: Mohamed Hisham
- *
- *******************************************************************************/
-
-/*******************************************************************************
- * INCLUSIONS                                                                  *
- *******************************************************************************/
-
-#include "NVIC.h"
-#include "tm4c123gh6pm_registers.h"
-
-/*******************************************************************************
- * FUNCTION DEFINITIONS                                                        *
- *******************************************************************************/
-
-/*********************************************************************
- * Service Name: NVIC_EnableIRQ
- * Sync/Async: Synchronous
- * Reentrancy: Reentrant
- * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Function to enable Interrupt request for specific IRQ
- **********************************************************************/
-void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num) {
-    if (IRQ_Num < 32) {
-        NVIC_EN0_REG = (1 << IRQ_Num);
-    } else if (IRQ_Num < 64) {
-        NVIC_EN1_REG = (1 << (IRQ_Num - 32));
-    } else if (IRQ_Num < 96) {
-        NVIC_EN2_REG = (1 << (IRQ_Num - 64));
-    } else if (IRQ_Num < 128) {
-        NVIC_EN3_REG = (1 << (IRQ_Num - 96));
-    } else {
-        NVIC_EN4_REG = (1 << (IRQ_Num - 128));
-    }
-}
-
-/*********************************************************************
- * Service Name: NVIC_DisableIRQ
- * Sync/Async: Synchronous
- * Reentrancy: Reentrant
- * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Function to disable Interrupt request for specific IRQ
- **********************************************************************/
-void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num) {
-    if (IRQ_Num < 32) {
-        NVIC_DIS0_REG = (1 << IRQ_Num);
-    } else if (IRQ_Num < 64) {
-        NVIC_DIS1_REG = (1 << (IRQ_Num - 32));
-    } else if (IRQ_Num < 96) {
-        NVIC_DIS2_REG = (1 << (IRQ_Num - 64));
-    } else if (IRQ_Num < 128) {
-        NVIC_DIS3_REG = (1 << (IRQ_Num - 96));
-    } else {
-        NVIC_DIS4_REG = (1 << (IRQ_Num - 128));
-    }
-}
-
-/*********************************************************************
- * Service Name: NVIC_SetPriorityIRQ
- * Sync/Async: Synchronous
- * Reentrancy: Reentrant
- * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
- *                  IRQ_Priority - Priority value for the IRQ
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Function to set the priority value for specific IRQ
- **********************************************************************/
-void NVIC_SetPriorityIRQ(NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType IRQ_Priority) {
-    if (IRQ_Priority > NVIC_PRIORITY_7) {
-        IRQ_Priority = NVIC_PRIORITY_7;
-    }
-    uint8 volatile *IRQSelectionPtr = NVIC_PRI0_REG_ONE_BYTE;
-    IRQSelectionPtr += IRQ_Num;
-    *IRQSelectionPtr &= ~(0x0E << 5);
-    *IRQSelectionPtr |= (IRQ_Priority << 5);
-
-//    uint8 reg_index = IRQ_Num / 4;
-//    uint8 byte_index = IRQ_Num % 4;
-//    uint8 priority_value = (IRQ_Priority << 5);
-//    NVIC_REG(NVIC_PRI0_REG, reg_index * 4) = NVIC_REG(NVIC_PRI0_REG, reg_index * 4) & ~(0xFF << (byte_index * 8));
-//    NVIC_REG(NVIC_PRI0_REG, reg_index * 4) = NVIC_REG(NVIC_PRI0_REG, reg_index * 4) | (priority_value << (byte_index * 8));
-
-}
-
-/*********************************************************************
- * Service Name: NVIC_EnableException
- * Sync/Async: Synchronous
- * Reentrancy: Reentrant
- * Parameters (in): Exception_Num - Number of the exception from the system control block
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Function to enable specific ARM system or fault exceptions
- **********************************************************************/
-void NVIC_EnableException(NVIC_ExceptionType Exception_Num) {
-    switch (Exception_Num) {
-        case EXCEPTION_RESET_TYPE:
-            /* Always Enabled */
-            break;
-        case EXCEPTION_NMI_TYPE:
-            /* Always Enabled */
-            break;
-        case EXCEPTION_HARD_FAULT_TYPE:
-            /* Always Enabled while FAULTMASK is Set */
-            break;
-        case EXCEPTION_MEM_FAULT_TYPE:
-            NVIC_SYSTEM_SYSHNDCTRL |= MEM_FAULT_ENABLE_MASK;
-            break;
-        case EXCEPTION_BUS_FAULT_TYPE:
-            NVIC_SYSTEM_SYSHNDCTRL |= BUS_FAULT_ENABLE_MASK;
-            break;
-        case EXCEPTION_USAGE_FAULT_TYPE:
-            NVIC_SYSTEM_SYSHNDCTRL |= USAGE_FAULT_ENABLE_MASK;
-            break;
-        case EXCEPTION_SVC_TYPE:
-            /* Only need to set Priority and enable General Exceptions */
-            break;
-        case EXCEPTION_DEBUG_MONITOR_TYPE:
-            NVIC_SYSTEM_SYSHNDCTRL |= (1<<8);
-            break;
-        case EXCEPTION_PEND_SV_TYPE:
-            /* Only need to set Priority and enable General Exceptions */
-            break;
-        case EXCEPTION_SYSTICK_TYPE:
-            /* Only need to set Priority and enable General Exceptions */
-            break;
-        default:
-            break;
-    }
-
-}
-
-/*********************************************************************
- * Service Name: NVIC_DisableException
- * Sync/Async: Synchronous
- * Reentrancy: Reentrant
- * Parameters (in): Exception_Num - Number of the exception from the system control block
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Function to disable specific ARM system or fault exceptions
- **********************************************************************/
-void NVIC_DisableException(NVIC_ExceptionType Exception_Num) {
-    switch (Exception_Num) {
-        case EXCEPTION_RESET_TYPE:
-            /* Can't be Disabled */
-            break;
-        case EXCEPTION_NMI_TYPE:
-            /* Can't be Disabled */
-            break;
-        case EXCEPTION_HARD_FAULT_TYPE:
-            /* Can't be Disabled while FAULTMASK is cleared */
-            break;
-        case EXCEPTION_MEM_FAULT_TYPE:
-            NVIC_SYSTEM_SYSHNDCTRL &= ~MEM_FAULT_ENABLE_MASK;
-            break;
-        case EXCEPTION_BUS_FAULT_TYPE:
-            NVIC_SYSTEM_SYSHNDCTRL &= ~BUS_FAULT_ENABLE_MASK;
-            break;
-        case EXCEPTION_USAGE_FAULT_TYPE:
-            NVIC_SYSTEM_SYSHNDCTRL &= ~USAGE_FAULT_ENABLE_MASK;
-            break;
-        case EXCEPTION_SVC_TYPE:
-            /* No specific disable needed */
-            break;
-        case EXCEPTION_DEBUG_MONITOR_TYPE:
-            NVIC_SYSTEM_SYSHNDCTRL &= ~(1<<8);
-            break;
-        case EXCEPTION_PEND_SV_TYPE:
-            /* No specific disable needed */
-            break;
-        case EXCEPTION_SYSTICK_TYPE:
-            /* No specific disable needed */
-            break;
-        default:
-            break;
-    }
-
-}
-
-/*********************************************************************
- * Service Name: NVIC_SetPriorityException
- * Sync/Async: Synchronous
- * Reentrancy: Reentrant
- * Parameters (in): Exception_Num - Number of the exception from the system control block
- *                  Exception_Priority - Priority value for the exception
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Function to set the priority value for specific ARM system or fault exceptions
- **********************************************************************/
-void NVIC_SetPriorityException(NVIC_ExceptionType Exception_Num, NVIC_ExceptionPriorityType Exception_Priority) {
-    if (Exception_Priority > NVIC_EXCEPTION_PRIORITY_7) {
-        Exception_Priority = NVIC_EXCEPTION_PRIORITY_7;
-    }
-    switch (Exception_Num) {
-        case EXCEPTION_RESET_TYPE:
-            /* Always priority -3 (Highest Priority) */
-            break;
-        case EXCEPTION_NMI_TYPE:
-            /* Always priority -2 */
-            break;
-        case EXCEPTION_HARD_FAULT_TYPE:
-            /* Always priority -1 */
-            break;
-        case EXCEPTION_MEM_FAULT_TYPE:
-            NVIC_SYSTEM_PRI1_REG &= ~(MEM_FAULT_PRIORITY_MASK);
-            NVIC_SYSTEM_PRI1_REG |= (Exception_Priority << MEM_FAULT_PRIORITY_BITS_POS);
-            break;
-        case EXCEPTION_BUS_FAULT_TYPE:
-            NVIC_SYSTEM_PRI1_REG &= ~(BUS_FAULT_PRIORITY_MASK);
-            NVIC_SYSTEM_PRI1_REG |= (Exception_Priority << BUS_FAULT_PRIORITY_BITS_POS);
-            break;
-        case EXCEPTION_USAGE_FAULT_TYPE:
-            NVIC_SYSTEM_PRI1_REG &= ~(USAGE_FAULT_PRIORITY_MASK);
-            NVIC_SYSTEM_PRI1_REG |= (Exception_Priority << USAGE_FAULT_PRIORITY_BITS_POS);
-            break;
-        case EXCEPTION_SVC_TYPE:
-            NVIC_SYSTEM_PRI2_REG &= ~(SVC_PRIORITY_MASK);
-            NVIC_SYSTEM_PRI2_REG |= (Exception_Priority << SVC_PRIORITY_BITS_POS);
-            break;
-        case EXCEPTION_DEBUG_MONITOR_TYPE:
-            NVIC_SYSTEM_PRI3_REG &= ~(DEBUG_MONITOR_PRIORITY_MASK);
-            NVIC_SYSTEM_PRI3_REG |= (Exception_Priority << DEBUG_MONITOR_PRIORITY_BITS_POS);
-            break;
-        case EXCEPTION_PEND_SV_TYPE:
-            NVIC_SYSTEM_PRI3_REG &= ~(PENDSV_PRIORITY_MASK);
-            NVIC_SYSTEM_PRI3_REG |= (Exception_Priority << PENDSV_PRIORITY_BITS_POS);
-            break;
-        case EXCEPTION_SYSTICK_TYPE:
-            NVIC_SYSTEM_PRI3_REG &= ~(SYSTICK_PRIORITY_MASK);
-            NVIC_SYSTEM_PRI3_REG |= (Exception_Priority << SYSTICK_PRIORITY_BITS_POS);
-            break;
-        default:
-            break;
-    }
-}
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC.c
+ *
+ * Description: Source file for the ARM Cortex M4 NVIC driver
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+
+#include "NVIC.h"
+#include "NVIC_Regs.h"
+#include "NVIC_Cfg.h"
+
+/*******************************************************************************
+ * CONFIGURATION IMAGES                                                        *
+ *******************************************************************************/
+
+/* Every NVIC_Cfg.h entry is checked at build time, an out-of-range priority or a
+ * reserved IRQ number of the selected part fails the build */
+#define NVIC_CFG_CHECK_IRQ(IRQ_Num, IRQ_Priority, Enabled) \
+    typedef char NVIC_CfgCheck_##IRQ_Num[(((uint32)(IRQ_Priority) <= NVIC_PRIORITY_MAX) && NVIC_IRQ_IS_VALID(IRQ_Num)) ? 1 : -1];
+#define NVIC_CFG_CHECK_EXCEPTION(Exception_Num, Exception_Priority, Enabled) \
+    typedef char NVIC_CfgCheck_##Exception_Num[((uint32)(Exception_Priority) <= NVIC_PRIORITY_MAX) ? 1 : -1];
+
+NVIC_CFG_IRQ_TABLE(NVIC_CFG_CHECK_IRQ)
+NVIC_CFG_EXCEPTION_TABLE(NVIC_CFG_CHECK_EXCEPTION)
+
+typedef char NVIC_CfgCheckGrouping[((NVIC_CFG_PRIORITY_GROUPING >= NVIC_PRIGROUP_ALL_PREEMPT) &&
+                                    (NVIC_CFG_PRIORITY_GROUPING <= NVIC_PRIGROUP_NO_PREEMPT)) ? 1 : -1];
+
+/* ENn images: one OR-term per table entry, each term is zero unless the IRQ lives in that word */
+#define NVIC_CFG_EN_BITS(Word, IRQ_Num, Enabled) \
+    ((((Enabled) != FALSE) && (NVIC_IRQ_WORD(IRQ_Num) == (Word))) ? NVIC_IRQ_BIT(IRQ_Num) : 0UL)
+#define NVIC_CFG_EN_WORD0(IRQ_Num, IRQ_Priority, Enabled)    | NVIC_CFG_EN_BITS(0UL, IRQ_Num, Enabled)
+#define NVIC_CFG_EN_WORD1(IRQ_Num, IRQ_Priority, Enabled)    | NVIC_CFG_EN_BITS(1UL, IRQ_Num, Enabled)
+#define NVIC_CFG_EN_WORD2(IRQ_Num, IRQ_Priority, Enabled)    | NVIC_CFG_EN_BITS(2UL, IRQ_Num, Enabled)
+#define NVIC_CFG_EN_WORD3(IRQ_Num, IRQ_Priority, Enabled)    | NVIC_CFG_EN_BITS(3UL, IRQ_Num, Enabled)
+#define NVIC_CFG_EN_WORD4(IRQ_Num, IRQ_Priority, Enabled)    | NVIC_CFG_EN_BITS(4UL, IRQ_Num, Enabled)
+#define NVIC_CFG_EN_WORD5(IRQ_Num, IRQ_Priority, Enabled)    | NVIC_CFG_EN_BITS(5UL, IRQ_Num, Enabled)
+#define NVIC_CFG_EN_WORD6(IRQ_Num, IRQ_Priority, Enabled)    | NVIC_CFG_EN_BITS(6UL, IRQ_Num, Enabled)
+#define NVIC_CFG_EN_WORD7(IRQ_Num, IRQ_Priority, Enabled)    | NVIC_CFG_EN_BITS(7UL, IRQ_Num, Enabled)
+
+/* Only the ENn words the part implements are emitted */
+static const uint32 NVIC_CfgEnableImage[NVIC_IRQ_REG_COUNT] = {
+    0UL NVIC_CFG_IRQ_TABLE(NVIC_CFG_EN_WORD0),
+#if (NVIC_IRQ_REG_COUNT > 1U)
+    0UL NVIC_CFG_IRQ_TABLE(NVIC_CFG_EN_WORD1),
+#endif
+#if (NVIC_IRQ_REG_COUNT > 2U)
+    0UL NVIC_CFG_IRQ_TABLE(NVIC_CFG_EN_WORD2),
+#endif
+#if (NVIC_IRQ_REG_COUNT > 3U)
+    0UL NVIC_CFG_IRQ_TABLE(NVIC_CFG_EN_WORD3),
+#endif
+#if (NVIC_IRQ_REG_COUNT > 4U)
+    0UL NVIC_CFG_IRQ_TABLE(NVIC_CFG_EN_WORD4),
+#endif
+#if (NVIC_IRQ_REG_COUNT > 5U)
+    0UL NVIC_CFG_IRQ_TABLE(NVIC_CFG_EN_WORD5),
+#endif
+#if (NVIC_IRQ_REG_COUNT > 6U)
+    0UL NVIC_CFG_IRQ_TABLE(NVIC_CFG_EN_WORD6),
+#endif
+#if (NVIC_IRQ_REG_COUNT > 7U)
+    0UL NVIC_CFG_IRQ_TABLE(NVIC_CFG_EN_WORD7),
+#endif
+};
+
+/* The valid-IRQ bitmap of the device descriptor may not name IRQs past its IRQ count */
+typedef char NVIC_DeviceBitmapCheck[(((NVIC_DEVICE_VALID_IRQ_WORD(0) & ~NVIC_DEVICE_IMPLEMENTED_WORD(0)) == 0UL) &&
+                                     ((NVIC_DEVICE_VALID_IRQ_WORD(1) & ~NVIC_DEVICE_IMPLEMENTED_WORD(1)) == 0UL) &&
+                                     ((NVIC_DEVICE_VALID_IRQ_WORD(2) & ~NVIC_DEVICE_IMPLEMENTED_WORD(2)) == 0UL) &&
+                                     ((NVIC_DEVICE_VALID_IRQ_WORD(3) & ~NVIC_DEVICE_IMPLEMENTED_WORD(3)) == 0UL) &&
+                                     ((NVIC_DEVICE_VALID_IRQ_WORD(4) & ~NVIC_DEVICE_IMPLEMENTED_WORD(4)) == 0UL) &&
+                                     ((NVIC_DEVICE_VALID_IRQ_WORD(5) & ~NVIC_DEVICE_IMPLEMENTED_WORD(5)) == 0UL) &&
+                                     ((NVIC_DEVICE_VALID_IRQ_WORD(6) & ~NVIC_DEVICE_IMPLEMENTED_WORD(6)) == 0UL) &&
+                                     ((NVIC_DEVICE_VALID_IRQ_WORD(7) & ~NVIC_DEVICE_IMPLEMENTED_WORD(7)) == 0UL)) ? 1 : -1];
+
+/* PRIn image (also the layout of the priority shadow): the priority bytes are placed with designated initializers at the
+ * IRQ number, which on the little-endian Cortex-M4 is the layout of PRI0-PRIn */
+typedef union {
+    uint8 Bytes[NVIC_PRI_REG_COUNT * 4U];
+    uint32 Words[NVIC_PRI_REG_COUNT];
+} NVIC_PriorityImageType;
+
+#define NVIC_CFG_PRI_BYTE(IRQ_Num, IRQ_Priority, Enabled) \
+    , [(IRQ_Num)] = (uint8)((uint32)(IRQ_Priority) << NVIC_PRIORITY_BITS_POS)
+
+static const NVIC_PriorityImageType NVIC_CfgPriorityImage = {
+    { [(NVIC_PRI_REG_COUNT * 4U) - 1U] = 0U NVIC_CFG_IRQ_TABLE(NVIC_CFG_PRI_BYTE) }
+};
+
+/* SYSPRI1-3 image: byte lane of each configurable exception, Reset/NMI/Hard Fault
+ * land in the unused fourth word */
+#define NVIC_CFG_SYSPRI_BYTE_INDEX(Exception_Num)                       \
+    (((Exception_Num) == EXCEPTION_MEM_FAULT_TYPE)     ? 0U  :          \
+     ((Exception_Num) == EXCEPTION_BUS_FAULT_TYPE)     ? 1U  :          \
+     ((Exception_Num) == EXCEPTION_USAGE_FAULT_TYPE)   ? 2U  :          \
+     ((Exception_Num) == EXCEPTION_SVC_TYPE)           ? 7U  :          \
+     ((Exception_Num) == EXCEPTION_DEBUG_MONITOR_TYPE) ? 8U  :          \
+     ((Exception_Num) == EXCEPTION_PEND_SV_TYPE)       ? 10U :          \
+     ((Exception_Num) == EXCEPTION_SYSTICK_TYPE)       ? 11U : 12U)
+
+typedef union {
+    uint8 Bytes[16];
+    uint32 Words[4];
+} NVIC_SysPriorityImageType;
+
+#define NVIC_CFG_SYSPRI_BYTE(Exception_Num, Exception_Priority, Enabled) \
+    , [NVIC_CFG_SYSPRI_BYTE_INDEX(Exception_Num)] = (uint8)((uint32)(Exception_Priority) << NVIC_PRIORITY_BITS_POS)
+
+static const NVIC_SysPriorityImageType NVIC_CfgSysPriorityImage = {
+    { [15] = 0U NVIC_CFG_EXCEPTION_TABLE(NVIC_CFG_SYSPRI_BYTE) }
+};
+
+/* SYSHNDCTRL image */
+#define NVIC_CFG_SYSHNDCTRL_BITS(Exception_Num, Exception_Priority, Enabled)                 \
+    | (((Enabled) == FALSE)                             ? 0UL :                             \
+       ((Exception_Num) == EXCEPTION_MEM_FAULT_TYPE)     ? (uint32)MEM_FAULT_ENABLE_MASK :   \
+       ((Exception_Num) == EXCEPTION_BUS_FAULT_TYPE)     ? (uint32)BUS_FAULT_ENABLE_MASK :   \
+       ((Exception_Num) == EXCEPTION_USAGE_FAULT_TYPE)   ? (uint32)USAGE_FAULT_ENABLE_MASK : \
+       ((Exception_Num) == EXCEPTION_DEBUG_MONITOR_TYPE) ? (uint32)DEBUG_MONITOR_ENABLE_MASK : 0UL)
+
+#define NVIC_CFG_SYSHNDCTRL_IMAGE    (0UL NVIC_CFG_EXCEPTION_TABLE(NVIC_CFG_SYSHNDCTRL_BITS))
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+/* RAM copy of the vector table, VTABLE requires it aligned to its rounded-up size */
+volatile NVIC_HandlerType NVIC_RamVectorTable[NVIC_VECTOR_COUNT] __attribute__((aligned(NVIC_VECTOR_TABLE_ALIGNMENT)));
+
+/* Vector number of each NVIC_ExceptionType */
+static const uint8 NVIC_ExceptionVector[] = {
+    1U,     /* EXCEPTION_RESET_TYPE         */
+    2U,     /* EXCEPTION_NMI_TYPE           */
+    3U,     /* EXCEPTION_HARD_FAULT_TYPE    */
+    4U,     /* EXCEPTION_MEM_FAULT_TYPE     */
+    5U,     /* EXCEPTION_BUS_FAULT_TYPE     */
+    6U,     /* EXCEPTION_USAGE_FAULT_TYPE   */
+    11U,    /* EXCEPTION_SVC_TYPE           */
+    12U,    /* EXCEPTION_DEBUG_MONITOR_TYPE */
+    14U,    /* EXCEPTION_PEND_SV_TYPE       */
+    15U,    /* EXCEPTION_SYSTICK_TYPE       */
+};
+
+/* Open NVIC_MaskSet scopes covering each IRQ, and the IRQs to re-enable when the
+ * last of them closes: those that were enabled when the first one opened */
+static uint8 NVIC_MaskDepth[NVIC_IRQ_COUNT];
+static uint32 NVIC_MaskRestore[NVIC_IRQ_REG_COUNT];
+
+#if NVIC_SHADOW_ENABLE
+
+/* RAM copy of the NVIC/SCB state written by the driver. The requested state is
+ * kept apart from what was last stored (Hw*) and the dirty bitmaps, so changes
+ * made inside NVIC_BeginUpdate/NVIC_CommitUpdate collapse to their net result.
+ * All zero is the reset state of the registers */
+typedef struct {
+    uint32 Enable[NVIC_IRQ_REG_COUNT];                          /* Requested ENn              */
+    uint32 HwEnable[NVIC_IRQ_REG_COUNT];                        /* ENn last stored            */
+    NVIC_PriorityImageType Priority;                            /* PRI0-PRIn                  */
+    NVIC_SysPriorityImageType SysPriority;                      /* SYSPRI1-3 (fourth unused)  */
+    uint32 SysHndCtrl;                                          /* Requested enable bits      */
+    uint32 HwSysHndCtrl;                                        /* Enable bits last stored    */
+    uint32 PriorityDirty[(NVIC_PRI_REG_COUNT + 31U) / 32U];     /* PRIn words not yet stored  */
+    uint8 SysPriorityDirty;                                     /* SYSPRIn words not yet stored */
+    boolean UpdateOpen;                                         /* Inside NVIC_BeginUpdate    */
+} NVIC_ShadowType;
+
+static NVIC_ShadowType NVIC_Shadow;
+
+#endif /* NVIC_SHADOW_ENABLE */
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+#if NVIC_SHADOW_ENABLE
+
+/* Store the difference between the requested and the last stored ENn word,
+ * called with PRIMASK set */
+static void NVIC_FlushEnableWord(uint32 RegIndex) {
+    uint32 SetBits = NVIC_Shadow.Enable[RegIndex] & ~NVIC_Shadow.HwEnable[RegIndex];
+    uint32 ClearBits = NVIC_Shadow.HwEnable[RegIndex] & ~NVIC_Shadow.Enable[RegIndex];
+    if (ClearBits != 0) {
+        NVIC_WRITE32(NVIC_DIS_ADDR(RegIndex), ClearBits);
+    }
+    if (SetBits != 0) {
+        NVIC_WRITE32(NVIC_EN_ADDR(RegIndex), SetBits);
+    }
+    NVIC_Shadow.HwEnable[RegIndex] = NVIC_Shadow.Enable[RegIndex];
+}
+
+/* Store the requested SYSHNDCTRL enables when they changed, called with PRIMASK set.
+ * The register also holds live active/pending status bits, so it stays a
+ * read-modify-write rather than a store of the shadow */
+static void NVIC_FlushSysHndCtrl(void) {
+    if (NVIC_Shadow.SysHndCtrl != NVIC_Shadow.HwSysHndCtrl) {
+        NVIC_WRITE32(NVIC_SYSTEM_SYSHNDCTRL_ADDR,
+                     (NVIC_READ32(NVIC_SYSTEM_SYSHNDCTRL_ADDR) & ~(uint32)SYSHNDCTRL_ENABLE_MASK) | NVIC_Shadow.SysHndCtrl);
+        NVIC_Shadow.HwSysHndCtrl = NVIC_Shadow.SysHndCtrl;
+    }
+}
+
+#endif /* NVIC_SHADOW_ENABLE */
+
+/* Set/clear bits of the ENn register RegIndex through ENn/DISn */
+static void NVIC_UpdateEnableWord(uint32 RegIndex, uint32 SetBits, uint32 ClearBits) {
+#if NVIC_SHADOW_ENABLE
+    uint32 Saved;
+    NVIC_ENTER_CRITICAL(Saved);
+    NVIC_Shadow.Enable[RegIndex] = (NVIC_Shadow.Enable[RegIndex] | SetBits) & ~ClearBits;
+    if (NVIC_Shadow.UpdateOpen == FALSE) {
+        NVIC_FlushEnableWord(RegIndex);
+    }
+    NVIC_EXIT_CRITICAL(Saved);
+#else
+    if (ClearBits != 0) {
+        NVIC_WRITE32(NVIC_DIS_ADDR(RegIndex), ClearBits);
+    }
+    if (SetBits != 0) {
+        NVIC_WRITE32(NVIC_EN_ADDR(RegIndex), SetBits);
+    }
+#endif
+}
+
+/* Set/clear bits of the ENn register RegIndex right away, even inside
+ * NVIC_BeginUpdate/NVIC_CommitUpdate. Returns the bits of ClearBits that were enabled */
+static uint32 NVIC_StoreEnableWordNow(uint32 RegIndex, uint32 SetBits, uint32 ClearBits) {
+    uint32 Saved;
+    uint32 Enabled;
+    NVIC_ENTER_CRITICAL(Saved);
+#if NVIC_SHADOW_ENABLE
+    Enabled = NVIC_Shadow.HwEnable[RegIndex];
+#else
+    Enabled = NVIC_READ32(NVIC_EN_ADDR(RegIndex));
+#endif
+    ClearBits &= Enabled;
+    SetBits &= ~Enabled;
+    if (ClearBits != 0) {
+        NVIC_WRITE32(NVIC_DIS_ADDR(RegIndex), ClearBits);
+    }
+    if (SetBits != 0) {
+        NVIC_WRITE32(NVIC_EN_ADDR(RegIndex), SetBits);
+    }
+#if NVIC_SHADOW_ENABLE
+    NVIC_Shadow.HwEnable[RegIndex] = (Enabled | SetBits) & ~ClearBits;
+    NVIC_Shadow.Enable[RegIndex] = (NVIC_Shadow.Enable[RegIndex] | SetBits) & ~ClearBits;
+#endif
+    NVIC_EXIT_CRITICAL(Saved);
+    return ClearBits;
+}
+
+/* Program the priority byte of an IRQ (already shifted to NVIC_PRIORITY_BITS_POS) */
+static void NVIC_UpdatePriorityByte(uint32 IRQ_Num, uint8 Value) {
+#if NVIC_SHADOW_ENABLE
+    uint32 Saved;
+    NVIC_ENTER_CRITICAL(Saved);
+    if (NVIC_Shadow.Priority.Bytes[IRQ_Num] != Value) {
+        NVIC_Shadow.Priority.Bytes[IRQ_Num] = Value;
+        if (NVIC_Shadow.UpdateOpen == FALSE) {
+            NVIC_WRITE8(NVIC_PRI0_ADDR + IRQ_Num, Value);
+        } else {
+            NVIC_Shadow.PriorityDirty[IRQ_Num >> 7] |= (1UL << ((IRQ_Num >> 2) & 31UL));
+        }
+    }
+    NVIC_EXIT_CRITICAL(Saved);
+#else
+    /* Only the top NVIC_PRIORITY_BITS bits of the priority byte are implemented,
+     * the rest read as zero, so the byte is stored without a read-modify-write */
+    NVIC_WRITE8(NVIC_PRI0_ADDR + IRQ_Num, Value);
+#endif
+}
+
+/* Program a whole PRIn word */
+static void NVIC_UpdatePriorityWord(uint32 RegIndex, uint32 Value) {
+#if NVIC_SHADOW_ENABLE
+    uint32 Saved;
+    NVIC_ENTER_CRITICAL(Saved);
+    if (NVIC_Shadow.Priority.Words[RegIndex] != Value) {
+        NVIC_Shadow.Priority.Words[RegIndex] = Value;
+        if (NVIC_Shadow.UpdateOpen == FALSE) {
+            NVIC_WRITE32(NVIC_PRI_ADDR(RegIndex), Value);
+        } else {
+            NVIC_Shadow.PriorityDirty[RegIndex >> 5] |= (1UL << (RegIndex & 31UL));
+        }
+    }
+    NVIC_EXIT_CRITICAL(Saved);
+#else
+    NVIC_WRITE32(NVIC_PRI_ADDR(RegIndex), Value);
+#endif
+}
+
+/* Replace the Mask field of SYSPRIn (RegIndex 0-2 for SYSPRI1-3) with Value: one
+ * read-modify-write, or a single store from the shadow when it is compiled in */
+static void NVIC_UpdateSysPriority(uint32 RegIndex, uint32 Mask, uint32 Value) {
+#if NVIC_SHADOW_ENABLE
+    uint32 Saved;
+    uint32 Word;
+    NVIC_ENTER_CRITICAL(Saved);
+    Word = (NVIC_Shadow.SysPriority.Words[RegIndex] & ~Mask) | (Value & Mask);
+    if (NVIC_Shadow.SysPriority.Words[RegIndex] != Word) {
+        NVIC_Shadow.SysPriority.Words[RegIndex] = Word;
+        if (NVIC_Shadow.UpdateOpen == FALSE) {
+            NVIC_WRITE32(NVIC_SYSTEM_PRI_ADDR(RegIndex), Word);
+        } else {
+            NVIC_Shadow.SysPriorityDirty |= (uint8)(1U << RegIndex);
+        }
+    }
+    NVIC_EXIT_CRITICAL(Saved);
+#else
+    /* The SYSPRIn word holds the priorities of other exceptions, which ISRs may
+     * update in between the read and the write */
+    uint32 Saved;
+    NVIC_ENTER_CRITICAL(Saved);
+    NVIC_WRITE32(NVIC_SYSTEM_PRI_ADDR(RegIndex),
+                 (NVIC_READ32(NVIC_SYSTEM_PRI_ADDR(RegIndex)) & ~Mask) | (Value & Mask));
+    NVIC_EXIT_CRITICAL(Saved);
+#endif
+}
+
+/* Set/clear exception enable bits of SYSHNDCTRL */
+static void NVIC_UpdateSysHndCtrl(uint32 SetBits, uint32 ClearBits) {
+#if NVIC_SHADOW_ENABLE
+    uint32 Saved;
+    NVIC_ENTER_CRITICAL(Saved);
+    NVIC_Shadow.SysHndCtrl = (NVIC_Shadow.SysHndCtrl | SetBits) & ~ClearBits;
+    if (NVIC_Shadow.UpdateOpen == FALSE) {
+        NVIC_FlushSysHndCtrl();
+    }
+    NVIC_EXIT_CRITICAL(Saved);
+#else
+    /* SYSHNDCTRL is on the Private Peripheral Bus, which has no bit-band alias, so
+     * the read-modify-write is kept short and guarded against ISRs updating it too */
+    uint32 Saved;
+    NVIC_ENTER_CRITICAL(Saved);
+    NVIC_WRITE32(NVIC_SYSTEM_SYSHNDCTRL_ADDR, (NVIC_READ32(NVIC_SYSTEM_SYSHNDCTRL_ADDR) | SetBits) & ~ClearBits);
+    NVIC_EXIT_CRITICAL(Saved);
+#endif
+}
+
+/* SYSHNDCTRL enable bit of an exception, 0 for the exceptions without one */
+static uint32 NVIC_ExceptionEnableMask(NVIC_ExceptionType Exception_Num) {
+    switch (Exception_Num) {
+        case EXCEPTION_MEM_FAULT_TYPE:
+            return MEM_FAULT_ENABLE_MASK;
+        case EXCEPTION_BUS_FAULT_TYPE:
+            return BUS_FAULT_ENABLE_MASK;
+        case EXCEPTION_USAGE_FAULT_TYPE:
+            return USAGE_FAULT_ENABLE_MASK;
+        case EXCEPTION_DEBUG_MONITOR_TYPE:
+            return DEBUG_MONITOR_ENABLE_MASK;
+        default:
+            return 0;
+    }
+}
+
+/* Current ENn, PRIn, SYSPRIn and SYSHNDCTRL enable state: from the shadow when it
+ * is compiled in, from the registers otherwise */
+static uint32 NVIC_CurrentEnableWord(uint32 RegIndex) {
+#if NVIC_SHADOW_ENABLE
+    return NVIC_Shadow.Enable[RegIndex];
+#else
+    return NVIC_READ32(NVIC_EN_ADDR(RegIndex));
+#endif
+}
+
+static uint32 NVIC_CurrentPriorityWord(uint32 RegIndex) {
+#if NVIC_SHADOW_ENABLE
+    return NVIC_Shadow.Priority.Words[RegIndex];
+#else
+    return NVIC_READ32(NVIC_PRI_ADDR(RegIndex));
+#endif
+}
+
+static uint32 NVIC_CurrentSysPriorityWord(uint32 RegIndex) {
+#if NVIC_SHADOW_ENABLE
+    return NVIC_Shadow.SysPriority.Words[RegIndex];
+#else
+    return NVIC_READ32(NVIC_SYSTEM_PRI_ADDR(RegIndex));
+#endif
+}
+
+static uint32 NVIC_CurrentSysHndCtrl(void) {
+#if NVIC_SHADOW_ENABLE
+    return NVIC_Shadow.SysHndCtrl;
+#else
+    return NVIC_READ32(NVIC_SYSTEM_SYSHNDCTRL_ADDR) & SYSHNDCTRL_ENABLE_MASK;
+#endif
+}
+
+#if NVIC_SHADOW_ENABLE
+
+/*********************************************************************
+ * Service Name: NVIC_EnableIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to enable Interrupt request for specific IRQ.
+ *              The store is skipped when the shadow shows the IRQ already enabled
+ **********************************************************************/
+void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num) {
+    if ((uint32)IRQ_Num >= NVIC_IRQ_COUNT) {
+        return;
+    }
+    NVIC_UpdateEnableWord(NVIC_IRQ_WORD(IRQ_Num), NVIC_IRQ_BIT(IRQ_Num), 0);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_DisableIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to disable Interrupt request for specific IRQ.
+ *              The store is skipped when the shadow shows the IRQ already disabled
+ **********************************************************************/
+void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num) {
+    if ((uint32)IRQ_Num >= NVIC_IRQ_COUNT) {
+        return;
+    }
+    NVIC_UpdateEnableWord(NVIC_IRQ_WORD(IRQ_Num), 0, NVIC_IRQ_BIT(IRQ_Num));
+}
+
+#endif /* NVIC_SHADOW_ENABLE */
+
+/*********************************************************************
+ * Service Name: NVIC_EnableIRQMask
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Mask - Set of IRQs to enable
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to enable a set of IRQs with at most one store per ENn register
+ **********************************************************************/
+void NVIC_EnableIRQMask(const NVIC_IRQMaskType *IRQ_Mask) {
+    uint8 RegIndex;
+    if (IRQ_Mask == NULL_PTR) {
+        return;
+    }
+    for (RegIndex = 0; RegIndex < NVIC_IRQ_REG_COUNT; RegIndex++) {
+        if (IRQ_Mask->Words[RegIndex] != 0) {
+            NVIC_UpdateEnableWord(RegIndex, IRQ_Mask->Words[RegIndex], 0);
+        }
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_DisableIRQMask
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Mask - Set of IRQs to disable
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to disable a set of IRQs with at most one store per DISn register
+ **********************************************************************/
+void NVIC_DisableIRQMask(const NVIC_IRQMaskType *IRQ_Mask) {
+    uint8 RegIndex;
+    if (IRQ_Mask == NULL_PTR) {
+        return;
+    }
+    for (RegIndex = 0; RegIndex < NVIC_IRQ_REG_COUNT; RegIndex++) {
+        if (IRQ_Mask->Words[RegIndex] != 0) {
+            NVIC_UpdateEnableWord(RegIndex, 0, IRQ_Mask->Words[RegIndex]);
+        }
+    }
+}
+
+/* IRQ bits of ENn word RegIndex that exist, the last word is only partly used */
+#define NVIC_MASK_VALID_WORD(RegIndex)                                          \
+    (((((RegIndex) + 1U) << 5) <= NVIC_IRQ_COUNT) ? 0xFFFFFFFFUL : ((1UL << (NVIC_IRQ_COUNT & 31UL)) - 1UL))
+
+/* Open (Open TRUE) or close a scope over the IRQs of Bits in word RegIndex, called
+ * with PRIMASK set. Returns the IRQs it is the first scope to open or the last to close */
+static uint32 NVIC_CountMaskScope(uint32 RegIndex, uint32 Bits, boolean Open) {
+    uint32 Edge = 0;
+    uint32 Bit;
+    uint8 *Depth;
+    for (Bit = 0; Bits != 0; Bit++, Bits >>= 1) {
+        if ((Bits & 1UL) == 0) {
+            continue;
+        }
+        Depth = &NVIC_MaskDepth[(RegIndex << 5) + Bit];
+        if (Open == TRUE) {
+            if (*Depth == 0) {
+                Edge |= (1UL << Bit);
+            }
+            (*Depth)++;
+        } else if (*Depth != 0) {
+            (*Depth)--;
+            if (*Depth == 0) {
+                Edge |= (1UL << Bit);
+            }
+        } else {
+            /* Not covered by any scope, nothing to close */
+        }
+    }
+    return Edge;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_MaskSet
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Mask - Set of IRQs to mask
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_MaskTokenType - IRQs of IRQ_Mask held masked by this scope
+ * Description: Function to open a critical section against a named set of IRQs only,
+ *              with one DISn store per affected word. No IRQ of the set runs once it
+ *              returns. Scopes nest and may close in any order: an IRQ is re-enabled
+ *              when the last scope covering it closes, and only if it was enabled
+ *              when the first one opened. Up to 255 scopes may cover one IRQ
+ **********************************************************************/
+NVIC_MaskTokenType NVIC_MaskSet(const NVIC_IRQMaskType *IRQ_Mask) {
+    NVIC_MaskTokenType Token;
+    uint32 RegIndex;
+    uint32 Saved;
+    uint32 First;
+    uint32 WordDisabled;
+    uint32 Disabled = 0;
+    NVIC_ENTER_CRITICAL(Saved);
+    for (RegIndex = 0; RegIndex < NVIC_IRQ_REG_COUNT; RegIndex++) {
+        Token.Words[RegIndex] = 0;
+        if (IRQ_Mask != NULL_PTR) {
+            Token.Words[RegIndex] = IRQ_Mask->Words[RegIndex] & NVIC_MASK_VALID_WORD(RegIndex);
+        }
+        if (Token.Words[RegIndex] != 0) {
+            First = NVIC_CountMaskScope(RegIndex, Token.Words[RegIndex], TRUE);
+            WordDisabled = NVIC_StoreEnableWordNow(RegIndex, 0, Token.Words[RegIndex]);
+            NVIC_MaskRestore[RegIndex] |= First & WordDisabled;
+            Disabled |= WordDisabled;
+        }
+    }
+    NVIC_EXIT_CRITICAL(Saved);
+    if (Disabled != 0) {
+        /* An IRQ already on its way in can still be taken right after the DISn
+         * store, the barriers make the disable effective before returning */
+        NVIC_DSB();
+        NVIC_ISB();
+    }
+    return Token;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_UnmaskSet
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Token - Value returned by the matching NVIC_MaskSet
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to close a NVIC_MaskSet scope, re-enabling the IRQs no other
+ *              open scope still covers, with one ENn store per affected word
+ **********************************************************************/
+void NVIC_UnmaskSet(const NVIC_MaskTokenType *Token) {
+    uint32 RegIndex;
+    uint32 Saved;
+    uint32 Last;
+    if (Token == NULL_PTR) {
+        return;
+    }
+    NVIC_ENTER_CRITICAL(Saved);
+    for (RegIndex = 0; RegIndex < NVIC_IRQ_REG_COUNT; RegIndex++) {
+        if ((Token->Words[RegIndex] & NVIC_MASK_VALID_WORD(RegIndex)) != 0) {
+            Last = NVIC_CountMaskScope(RegIndex, Token->Words[RegIndex] & NVIC_MASK_VALID_WORD(RegIndex), FALSE);
+            if ((Last & NVIC_MaskRestore[RegIndex]) != 0) {
+                (void)NVIC_StoreEnableWordNow(RegIndex, Last & NVIC_MaskRestore[RegIndex], 0);
+            }
+            NVIC_MaskRestore[RegIndex] &= ~Last;
+        }
+    }
+    NVIC_EXIT_CRITICAL(Saved);
+}
+
+/* Collect a list of IRQs into a register-layout mask */
+static void NVIC_BuildIRQMask(NVIC_IRQMaskType *IRQ_Mask, const NVIC_IRQType *IRQ_List, uint8 IRQ_Count) {
+    uint8 Index;
+    for (Index = 0; Index < NVIC_IRQ_REG_COUNT; Index++) {
+        IRQ_Mask->Words[Index] = 0;
+    }
+    for (Index = 0; Index < IRQ_Count; Index++) {
+        NVIC_IRQ_MASK_ADD(*IRQ_Mask, IRQ_List[Index]);
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_EnableIRQList
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_List - Array of IRQs to enable
+ *                  IRQ_Count - Number of entries in IRQ_List
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to enable a list of IRQs with at most one store per ENn register
+ **********************************************************************/
+void NVIC_EnableIRQList(const NVIC_IRQType *IRQ_List, uint8 IRQ_Count) {
+    NVIC_IRQMaskType IRQ_Mask;
+    if (IRQ_List == NULL_PTR) {
+        return;
+    }
+    NVIC_BuildIRQMask(&IRQ_Mask, IRQ_List, IRQ_Count);
+    NVIC_EnableIRQMask(&IRQ_Mask);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_DisableIRQList
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_List - Array of IRQs to disable
+ *                  IRQ_Count - Number of entries in IRQ_List
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to disable a list of IRQs with at most one store per DISn register
+ **********************************************************************/
+void NVIC_DisableIRQList(const NVIC_IRQType *IRQ_List, uint8 IRQ_Count) {
+    NVIC_IRQMaskType IRQ_Mask;
+    if (IRQ_List == NULL_PTR) {
+        return;
+    }
+    NVIC_BuildIRQMask(&IRQ_Mask, IRQ_List, IRQ_Count);
+    NVIC_DisableIRQMask(&IRQ_Mask);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_SetPending
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Mask - Set of IRQs to pend
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to pend a set of IRQs with at most one store per PENDn register
+ **********************************************************************/
+void NVIC_SetPending(const NVIC_IRQMaskType *IRQ_Mask) {
+    uint8 RegIndex;
+    if (IRQ_Mask == NULL_PTR) {
+        return;
+    }
+    for (RegIndex = 0; RegIndex < NVIC_IRQ_REG_COUNT; RegIndex++) {
+        if (IRQ_Mask->Words[RegIndex] != 0) {
+            NVIC_WRITE32(NVIC_PEND_ADDR(RegIndex), IRQ_Mask->Words[RegIndex]);
+        }
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_ClearPending
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Mask - Set of IRQs to un-pend
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to un-pend a set of IRQs with at most one store per UNPENDn register
+ **********************************************************************/
+void NVIC_ClearPending(const NVIC_IRQMaskType *IRQ_Mask) {
+    uint8 RegIndex;
+    if (IRQ_Mask == NULL_PTR) {
+        return;
+    }
+    for (RegIndex = 0; RegIndex < NVIC_IRQ_REG_COUNT; RegIndex++) {
+        if (IRQ_Mask->Words[RegIndex] != 0) {
+            NVIC_WRITE32(NVIC_UNPEND_ADDR(RegIndex), IRQ_Mask->Words[RegIndex]);
+        }
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_IsPending
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the IRQ is pending
+ * Description: Function to check the PENDn bit of an IRQ
+ **********************************************************************/
+boolean NVIC_IsPending(NVIC_IRQType IRQ_Num) {
+    if ((uint32)IRQ_Num >= NVIC_IRQ_COUNT) {
+        return FALSE;
+    }
+    return ((NVIC_READ32(NVIC_PEND_ADDR(NVIC_IRQ_WORD(IRQ_Num))) & NVIC_IRQ_BIT(IRQ_Num)) != 0) ? TRUE : FALSE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_IsActive
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the IRQ handler is running or preempted
+ * Description: Function to check the ACTIVEn bit of an IRQ
+ **********************************************************************/
+boolean NVIC_IsActive(NVIC_IRQType IRQ_Num) {
+    if ((uint32)IRQ_Num >= NVIC_IRQ_COUNT) {
+        return FALSE;
+    }
+    return ((NVIC_READ32(NVIC_ACTIVE_ADDR(NVIC_IRQ_WORD(IRQ_Num))) & NVIC_IRQ_BIT(IRQ_Num)) != 0) ? TRUE : FALSE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_AllowUnprivilegedTrigger
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Allow - TRUE to let unprivileged code write SWTRIG
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set or clear CFGCTRL.MAINPEND. Must run privileged
+ **********************************************************************/
+void NVIC_AllowUnprivilegedTrigger(boolean Allow) {
+    /* CFGCTRL also holds the fault trapping bits, kept across the read-modify-write */
+    uint32 Saved;
+    NVIC_ENTER_CRITICAL(Saved);
+    if (Allow == TRUE) {
+        NVIC_WRITE32(NVIC_SYSTEM_CFGCTRL_ADDR, NVIC_READ32(NVIC_SYSTEM_CFGCTRL_ADDR) | CFGCTRL_MAINPEND_MASK);
+    } else {
+        NVIC_WRITE32(NVIC_SYSTEM_CFGCTRL_ADDR, NVIC_READ32(NVIC_SYSTEM_CFGCTRL_ADDR) & ~CFGCTRL_MAINPEND_MASK);
+    }
+    NVIC_EXIT_CRITICAL(Saved);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_SetPriorityIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ *                  IRQ_Priority - Priority value for the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set the priority value for specific IRQ
+ **********************************************************************/
+void NVIC_SetPriorityIRQ(NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType IRQ_Priority) {
+    if ((uint32)IRQ_Num >= NVIC_IRQ_COUNT) {
+        return;
+    }
+    if ((uint32)IRQ_Priority > NVIC_PRIORITY_MAX) {
+        IRQ_Priority = (NVIC_IRQPriorityType)NVIC_PRIORITY_MAX;
+    }
+    NVIC_UpdatePriorityByte((uint32)IRQ_Num, (uint8)(IRQ_Priority << NVIC_PRIORITY_BITS_POS));
+}
+
+/*********************************************************************
+ * Service Name: NVIC_ApplyPriorityTable
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Priority_Table - Array of (IRQ, priority) pairs
+ *                  Table_Size - Number of entries in Priority_Table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to program the priorities of a table of IRQs with one
+ *              store per affected PRIn register and no read-back. IRQs sharing a
+ *              PRIn register with a table entry but missing from the table are
+ *              programmed to NVIC_PRIORITY_0 (the reset value). Entries with an
+ *              out-of-range or reserved IRQ are skipped
+ **********************************************************************/
+void NVIC_ApplyPriorityTable(const NVIC_IRQPriorityConfigType *Priority_Table, uint8 Table_Size) {
+    uint32 PriorityWords[NVIC_PRI_REG_COUNT];
+    uint32 UsedWords[(NVIC_PRI_REG_COUNT + 31U) / 32U];
+    uint8 Index;
+    uint32 RegIndex;
+    NVIC_IRQPriorityType IRQ_Priority;
+
+    if (Priority_Table == NULL_PTR) {
+        return;
+    }
+    for (Index = 0; Index < (NVIC_PRI_REG_COUNT + 31U) / 32U; Index++) {
+        UsedWords[Index] = 0;
+    }
+    for (Index = 0; Index < Table_Size; Index++) {
+        if (!NVIC_IRQ_IS_VALID(Priority_Table[Index].IRQ_Num)) {
+            continue;
+        }
+        IRQ_Priority = Priority_Table[Index].IRQ_Priority;
+        if ((uint32)IRQ_Priority > NVIC_PRIORITY_MAX) {
+            IRQ_Priority = (NVIC_IRQPriorityType)NVIC_PRIORITY_MAX;
+        }
+        RegIndex = (uint32)Priority_Table[Index].IRQ_Num >> 2;
+        if ((UsedWords[RegIndex >> 5] & (1UL << (RegIndex & 31UL))) == 0) {
+            UsedWords[RegIndex >> 5] |= (1UL << (RegIndex & 31UL));
+            PriorityWords[RegIndex] = 0;
+        }
+        PriorityWords[RegIndex] &= ~NVIC_PRI_FIELD(Priority_Table[Index].IRQ_Num, NVIC_PRIORITY_MAX);
+        PriorityWords[RegIndex] |= NVIC_PRI_FIELD(Priority_Table[Index].IRQ_Num, IRQ_Priority);
+    }
+    for (RegIndex = 0; RegIndex < NVIC_PRI_REG_COUNT; RegIndex++) {
+        if ((UsedWords[RegIndex >> 5] & (1UL << (RegIndex & 31UL))) != 0) {
+            NVIC_UpdatePriorityWord(RegIndex, PriorityWords[RegIndex]);
+        }
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_ApplyPriorityArray
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Priority_Array - Priority of every IRQ, indexed by IRQ number
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to program the priorities of all the IRQs with exactly
+ *              one store per PRIn register
+ **********************************************************************/
+void NVIC_ApplyPriorityArray(const NVIC_IRQPriorityType Priority_Array[NVIC_IRQ_COUNT]) {
+    uint32 RegIndex;
+    uint32 IRQ_Num;
+    uint32 PriorityWord;
+    NVIC_IRQPriorityType IRQ_Priority;
+
+    if (Priority_Array == NULL_PTR) {
+        return;
+    }
+    for (RegIndex = 0; RegIndex < NVIC_PRI_REG_COUNT; RegIndex++) {
+        PriorityWord = 0;
+        for (IRQ_Num = RegIndex << 2; (IRQ_Num < ((RegIndex + 1U) << 2)) && (IRQ_Num < NVIC_IRQ_COUNT); IRQ_Num++) {
+            IRQ_Priority = Priority_Array[IRQ_Num];
+            if ((uint32)IRQ_Priority > NVIC_PRIORITY_MAX) {
+                IRQ_Priority = (NVIC_IRQPriorityType)NVIC_PRIORITY_MAX;
+            }
+            PriorityWord |= NVIC_PRI_FIELD(IRQ_Num, IRQ_Priority);
+        }
+        NVIC_UpdatePriorityWord(RegIndex, PriorityWord);
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_EnableException
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Number of the exception from the system control block
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to enable specific ARM system or fault exceptions
+ **********************************************************************/
+void NVIC_EnableException(NVIC_ExceptionType Exception_Num) {
+    switch (Exception_Num) {
+        case EXCEPTION_RESET_TYPE:
+            /* Always Enabled */
+            break;
+        case EXCEPTION_NMI_TYPE:
+            /* Always Enabled */
+            break;
+        case EXCEPTION_HARD_FAULT_TYPE:
+            /* Always Enabled while FAULTMASK is Set */
+            break;
+        case EXCEPTION_MEM_FAULT_TYPE:
+            NVIC_UpdateSysHndCtrl(MEM_FAULT_ENABLE_MASK, 0);
+            break;
+        case EXCEPTION_BUS_FAULT_TYPE:
+            NVIC_UpdateSysHndCtrl(BUS_FAULT_ENABLE_MASK, 0);
+            break;
+        case EXCEPTION_USAGE_FAULT_TYPE:
+            NVIC_UpdateSysHndCtrl(USAGE_FAULT_ENABLE_MASK, 0);
+            break;
+        case EXCEPTION_SVC_TYPE:
+            /* Only need to set Priority and enable General Exceptions */
+            break;
+        case EXCEPTION_DEBUG_MONITOR_TYPE:
+            NVIC_UpdateSysHndCtrl(DEBUG_MONITOR_ENABLE_MASK, 0);
+            break;
+        case EXCEPTION_PEND_SV_TYPE:
+            /* Only need to set Priority and enable General Exceptions */
+            break;
+        case EXCEPTION_SYSTICK_TYPE:
+            /* Only need to set Priority and enable General Exceptions */
+            break;
+        default:
+            break;
+    }
+
+}
+
+/*********************************************************************
+ * Service Name: NVIC_DisableException
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Number of the exception from the system control block
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to disable specific ARM system or fault exceptions
+ **********************************************************************/
+void NVIC_DisableException(NVIC_ExceptionType Exception_Num) {
+    switch (Exception_Num) {
+        case EXCEPTION_RESET_TYPE:
+            /* Can't be Disabled */
+            break;
+        case EXCEPTION_NMI_TYPE:
+            /* Can't be Disabled */
+            break;
+        case EXCEPTION_HARD_FAULT_TYPE:
+            /* Can't be Disabled while FAULTMASK is cleared */
+            break;
+        case EXCEPTION_MEM_FAULT_TYPE:
+            NVIC_UpdateSysHndCtrl(0, MEM_FAULT_ENABLE_MASK);
+            break;
+        case EXCEPTION_BUS_FAULT_TYPE:
+            NVIC_UpdateSysHndCtrl(0, BUS_FAULT_ENABLE_MASK);
+            break;
+        case EXCEPTION_USAGE_FAULT_TYPE:
+            NVIC_UpdateSysHndCtrl(0, USAGE_FAULT_ENABLE_MASK);
+            break;
+        case EXCEPTION_SVC_TYPE:
+            /* No specific disable needed */
+            break;
+        case EXCEPTION_DEBUG_MONITOR_TYPE:
+            NVIC_UpdateSysHndCtrl(0, DEBUG_MONITOR_ENABLE_MASK);
+            break;
+        case EXCEPTION_PEND_SV_TYPE:
+            /* No specific disable needed */
+            break;
+        case EXCEPTION_SYSTICK_TYPE:
+            /* No specific disable needed */
+            break;
+        default:
+            break;
+    }
+
+}
+
+/*********************************************************************
+ * Service Name: NVIC_SetPriorityException
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Number of the exception from the system control block
+ *                  Exception_Priority - Priority value for the exception
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set the priority value for specific ARM system or fault exceptions
+ **********************************************************************/
+void NVIC_SetPriorityException(NVIC_ExceptionType Exception_Num, NVIC_ExceptionPriorityType Exception_Priority) {
+    if ((uint32)Exception_Priority > NVIC_PRIORITY_MAX) {
+        Exception_Priority = (NVIC_ExceptionPriorityType)NVIC_PRIORITY_MAX;
+    }
+    switch (Exception_Num) {
+        case EXCEPTION_RESET_TYPE:
+            /* Always priority -3 (Highest Priority) */
+            break;
+        case EXCEPTION_NMI_TYPE:
+            /* Always priority -2 */
+            break;
+        case EXCEPTION_HARD_FAULT_TYPE:
+            /* Always priority -1 */
+            break;
+        case EXCEPTION_MEM_FAULT_TYPE:
+            NVIC_UpdateSysPriority(0U, MEM_FAULT_PRIORITY_MASK, (uint32)Exception_Priority << MEM_FAULT_PRIORITY_BITS_POS);
+            break;
+        case EXCEPTION_BUS_FAULT_TYPE:
+            NVIC_UpdateSysPriority(0U, BUS_FAULT_PRIORITY_MASK, (uint32)Exception_Priority << BUS_FAULT_PRIORITY_BITS_POS);
+            break;
+        case EXCEPTION_USAGE_FAULT_TYPE:
+            NVIC_UpdateSysPriority(0U, USAGE_FAULT_PRIORITY_MASK, (uint32)Exception_Priority << USAGE_FAULT_PRIORITY_BITS_POS);
+            break;
+        case EXCEPTION_SVC_TYPE:
+            NVIC_UpdateSysPriority(1U, SVC_PRIORITY_MASK, (uint32)Exception_Priority << SVC_PRIORITY_BITS_POS);
+            break;
+        case EXCEPTION_DEBUG_MONITOR_TYPE:
+            NVIC_UpdateSysPriority(2U, DEBUG_MONITOR_PRIORITY_MASK, (uint32)Exception_Priority << DEBUG_MONITOR_PRIORITY_BITS_POS);
+            break;
+        case EXCEPTION_PEND_SV_TYPE:
+            NVIC_UpdateSysPriority(2U, PENDSV_PRIORITY_MASK, (uint32)Exception_Priority << PENDSV_PRIORITY_BITS_POS);
+            break;
+        case EXCEPTION_SYSTICK_TYPE:
+            NVIC_UpdateSysPriority(2U, SYSTICK_PRIORITY_MASK, (uint32)Exception_Priority << SYSTICK_PRIORITY_BITS_POS);
+            break;
+        default:
+            break;
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_InitFromConfig
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to program the IRQ and exception configuration of
+ *              NVIC_Cfg.h. The register images are generated at build time,
+ *              so this only stores the priority grouping and precomputed PRIn,
+ *              SYSPRI1-3, SYSHNDCTRL and ENn words. Must be called from thread
+ *              mode during start-up
+ **********************************************************************/
+void NVIC_InitFromConfig(void) {
+    uint8 RegIndex;
+#if NVIC_SHADOW_ENABLE
+    uint32 Saved;
+    NVIC_ENTER_CRITICAL(Saved);
+    NVIC_Shadow.Priority = NVIC_CfgPriorityImage;
+    NVIC_Shadow.SysPriority = NVIC_CfgSysPriorityImage;
+    NVIC_Shadow.SysHndCtrl = NVIC_CFG_SYSHNDCTRL_IMAGE;
+    NVIC_Shadow.HwSysHndCtrl = NVIC_CFG_SYSHNDCTRL_IMAGE;
+    NVIC_Shadow.SysPriorityDirty = 0;
+    for (RegIndex = 0; RegIndex < (NVIC_PRI_REG_COUNT + 31U) / 32U; RegIndex++) {
+        NVIC_Shadow.PriorityDirty[RegIndex] = 0;
+    }
+    for (RegIndex = 0; RegIndex < NVIC_IRQ_REG_COUNT; RegIndex++) {
+        NVIC_Shadow.HwEnable[RegIndex] |= NVIC_CfgEnableImage[RegIndex];
+        NVIC_Shadow.Enable[RegIndex] |= NVIC_CfgEnableImage[RegIndex];
+    }
+    NVIC_EXIT_CRITICAL(Saved);
+#endif
+
+    /* Grouping and priorities first so no IRQ runs with its reset priority */
+    NVIC_SetPriorityGrouping(NVIC_CFG_PRIORITY_GROUPING);
+    for (RegIndex = 0; RegIndex < NVIC_PRI_REG_COUNT; RegIndex++) {
+        NVIC_WRITE32(NVIC_PRI_ADDR(RegIndex), NVIC_CfgPriorityImage.Words[RegIndex]);
+    }
+    NVIC_WRITE32(NVIC_SYSTEM_PRI1_ADDR, NVIC_CfgSysPriorityImage.Words[0]);
+    NVIC_WRITE32(NVIC_SYSTEM_PRI2_ADDR, NVIC_CfgSysPriorityImage.Words[1]);
+    NVIC_WRITE32(NVIC_SYSTEM_PRI3_ADDR, NVIC_CfgSysPriorityImage.Words[2]);
+
+    NVIC_WRITE32(NVIC_SYSTEM_SYSHNDCTRL_ADDR, NVIC_CFG_SYSHNDCTRL_IMAGE);
+
+    for (RegIndex = 0; RegIndex < NVIC_IRQ_REG_COUNT; RegIndex++) {
+        if (NVIC_CfgEnableImage[RegIndex] != 0) {
+            NVIC_WRITE32(NVIC_EN_ADDR(RegIndex), NVIC_CfgEnableImage[RegIndex]);
+        }
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_IsIRQEnabled
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the IRQ is enabled
+ * Description: Function to check whether an IRQ is enabled, answered from the
+ *              shadow when it is compiled in, from ENn otherwise
+ **********************************************************************/
+boolean NVIC_IsIRQEnabled(NVIC_IRQType IRQ_Num) {
+    uint32 EnableWord;
+    if ((uint32)IRQ_Num >= NVIC_IRQ_COUNT) {
+        return FALSE;
+    }
+    EnableWord = NVIC_CurrentEnableWord(NVIC_IRQ_WORD(IRQ_Num));
+    return ((EnableWord & NVIC_IRQ_BIT(IRQ_Num)) != 0) ? TRUE : FALSE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_GetPriorityIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_IRQPriorityType - Priority of the IRQ
+ * Description: Function to get the priority of an IRQ, answered from the
+ *              shadow when it is compiled in, from PRIn otherwise
+ **********************************************************************/
+NVIC_IRQPriorityType NVIC_GetPriorityIRQ(NVIC_IRQType IRQ_Num) {
+    uint8 PriorityByte;
+    if ((uint32)IRQ_Num >= NVIC_IRQ_COUNT) {
+        return NVIC_PRIORITY_0;
+    }
+#if NVIC_SHADOW_ENABLE
+    PriorityByte = NVIC_Shadow.Priority.Bytes[IRQ_Num];
+#else
+    PriorityByte = NVIC_READ8(NVIC_PRI0_ADDR + (uint32)IRQ_Num);
+#endif
+    return (NVIC_IRQPriorityType)(PriorityByte >> NVIC_PRIORITY_BITS_POS);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_IsExceptionEnabled
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Number of the exception from the system control block
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the exception is enabled
+ * Description: Function to check the SYSHNDCTRL enable bit of the fault and debug
+ *              monitor exceptions, the other exceptions have none and report TRUE
+ **********************************************************************/
+boolean NVIC_IsExceptionEnabled(NVIC_ExceptionType Exception_Num) {
+    uint32 EnableMask = NVIC_ExceptionEnableMask(Exception_Num);
+    uint32 EnableBits;
+    if (EnableMask == 0) {
+        return TRUE;
+    }
+    EnableBits = NVIC_CurrentSysHndCtrl();
+    return ((EnableBits & EnableMask) != 0) ? TRUE : FALSE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_GetPriorityException
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Number of the exception from the system control block
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_ExceptionPriorityType - Priority of the exception
+ * Description: Function to get the priority of a configurable exception. Reset,
+ *              NMI and Hard Fault have fixed negative priorities and report
+ *              NVIC_EXCEPTION_PRIORITY_0
+ **********************************************************************/
+NVIC_ExceptionPriorityType NVIC_GetPriorityException(NVIC_ExceptionType Exception_Num) {
+    uint32 ByteIndex = NVIC_CFG_SYSPRI_BYTE_INDEX(Exception_Num);
+    uint8 PriorityByte;
+    if (ByteIndex >= 12U) {
+        return NVIC_EXCEPTION_PRIORITY_0;
+    }
+#if NVIC_SHADOW_ENABLE
+    PriorityByte = NVIC_Shadow.SysPriority.Bytes[ByteIndex];
+#else
+    PriorityByte = NVIC_READ8(NVIC_SYSTEM_PRI1_ADDR + ByteIndex);
+#endif
+    return (NVIC_ExceptionPriorityType)(PriorityByte >> NVIC_PRIORITY_BITS_POS);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_BeginUpdate
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to start coalescing enable, priority and SYSHNDCTRL changes
+ *              in the shadow. Nothing reaches the registers until NVIC_CommitUpdate,
+ *              including changes made by ISRs in between. No effect without the shadow
+ **********************************************************************/
+void NVIC_BeginUpdate(void) {
+#if NVIC_SHADOW_ENABLE
+    NVIC_Shadow.UpdateOpen = TRUE;
+#endif
+}
+
+/*********************************************************************
+ * Service Name: NVIC_CommitUpdate
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to write the net result of the changes made since
+ *              NVIC_BeginUpdate: one store per changed register, priorities
+ *              before enables. No effect without the shadow
+ **********************************************************************/
+void NVIC_CommitUpdate(void) {
+#if NVIC_SHADOW_ENABLE
+    uint32 Saved;
+    uint32 RegIndex;
+    NVIC_ENTER_CRITICAL(Saved);
+    for (RegIndex = 0; RegIndex < NVIC_PRI_REG_COUNT; RegIndex++) {
+        if ((NVIC_Shadow.PriorityDirty[RegIndex >> 5] & (1UL << (RegIndex & 31UL))) != 0) {
+            NVIC_WRITE32(NVIC_PRI_ADDR(RegIndex), NVIC_Shadow.Priority.Words[RegIndex]);
+        }
+    }
+    for (RegIndex = 0; RegIndex < (NVIC_PRI_REG_COUNT + 31U) / 32U; RegIndex++) {
+        NVIC_Shadow.PriorityDirty[RegIndex] = 0;
+    }
+    for (RegIndex = 0; RegIndex < NVIC_SYSPRI_REG_COUNT; RegIndex++) {
+        if ((NVIC_Shadow.SysPriorityDirty & (1U << RegIndex)) != 0) {
+            NVIC_WRITE32(NVIC_SYSTEM_PRI_ADDR(RegIndex), NVIC_Shadow.SysPriority.Words[RegIndex]);
+        }
+    }
+    NVIC_Shadow.SysPriorityDirty = 0;
+    NVIC_FlushSysHndCtrl();
+    for (RegIndex = 0; RegIndex < NVIC_IRQ_REG_COUNT; RegIndex++) {
+        NVIC_FlushEnableWord(RegIndex);
+    }
+    NVIC_Shadow.UpdateOpen = FALSE;
+    NVIC_EXIT_CRITICAL(Saved);
+#endif
+}
+
+/*********************************************************************
+ * Service Name: NVIC_SyncShadow
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to reload the shadow from the registers. The shadow starts
+ *              from the reset state, so this is only needed when something outside
+ *              the driver (e.g. a bootloader) programmed the NVIC. No effect without the shadow
+ **********************************************************************/
+void NVIC_SyncShadow(void) {
+#if NVIC_SHADOW_ENABLE
+    uint32 Saved;
+    uint32 RegIndex;
+    NVIC_ENTER_CRITICAL(Saved);
+    for (RegIndex = 0; RegIndex < NVIC_IRQ_REG_COUNT; RegIndex++) {
+        NVIC_Shadow.Enable[RegIndex] = NVIC_READ32(NVIC_EN_ADDR(RegIndex));
+        NVIC_Shadow.HwEnable[RegIndex] = NVIC_Shadow.Enable[RegIndex];
+    }
+    for (RegIndex = 0; RegIndex < NVIC_PRI_REG_COUNT; RegIndex++) {
+        NVIC_Shadow.Priority.Words[RegIndex] = NVIC_READ32(NVIC_PRI_ADDR(RegIndex));
+    }
+    for (RegIndex = 0; RegIndex < (NVIC_PRI_REG_COUNT + 31U) / 32U; RegIndex++) {
+        NVIC_Shadow.PriorityDirty[RegIndex] = 0;
+    }
+    for (RegIndex = 0; RegIndex < NVIC_SYSPRI_REG_COUNT; RegIndex++) {
+        NVIC_Shadow.SysPriority.Words[RegIndex] = NVIC_READ32(NVIC_SYSTEM_PRI_ADDR(RegIndex));
+    }
+    NVIC_Shadow.SysPriorityDirty = 0;
+    NVIC_Shadow.SysHndCtrl = NVIC_READ32(NVIC_SYSTEM_SYSHNDCTRL_ADDR) & SYSHNDCTRL_ENABLE_MASK;
+    NVIC_Shadow.HwSysHndCtrl = NVIC_Shadow.SysHndCtrl;
+    NVIC_Shadow.UpdateOpen = FALSE;
+    NVIC_EXIT_CRITICAL(Saved);
+#endif
+}
+
+/*********************************************************************
+ * Service Name: NVIC_SaveState
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): State - Enable, priority and exception enable state
+ * Return value: None
+ * Description: Function to take a snapshot of the ENn, PRIn, SYSPRIn and SYSHNDCTRL
+ *              enable state, copied from the shadow when it is compiled in
+ **********************************************************************/
+void NVIC_SaveState(NVIC_StateType *State) {
+    uint32 RegIndex;
+    if (State == NULL_PTR) {
+        return;
+    }
+    for (RegIndex = 0; RegIndex < NVIC_IRQ_REG_COUNT; RegIndex++) {
+        State->Enable[RegIndex] = NVIC_CurrentEnableWord(RegIndex);
+    }
+    for (RegIndex = 0; RegIndex < NVIC_PRI_REG_COUNT; RegIndex++) {
+        State->Priority[RegIndex] = NVIC_CurrentPriorityWord(RegIndex);
+    }
+    for (RegIndex = 0; RegIndex < NVIC_SYSPRI_REG_COUNT; RegIndex++) {
+        State->SysPriority[RegIndex] = NVIC_CurrentSysPriorityWord(RegIndex);
+    }
+    State->SysHndCtrl = NVIC_CurrentSysHndCtrl();
+}
+
+/*********************************************************************
+ * Service Name: NVIC_RestoreState
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): State - Snapshot taken by NVIC_SaveState
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to program every register of a snapshot whatever the
+ *              current state, e.g. from retained RAM after the NVIC lost its
+ *              state. Priorities are restored before the enables. Inside an open
+ *              NVIC_BeginUpdate the snapshot is written at once and replaces the
+ *              changes coalesced so far; later ones wait for NVIC_CommitUpdate
+ **********************************************************************/
+void NVIC_RestoreState(const NVIC_StateType *State) {
+    uint32 RegIndex;
+    uint32 Saved;
+    if (State == NULL_PTR) {
+        return;
+    }
+    NVIC_ENTER_CRITICAL(Saved);
+    for (RegIndex = 0; RegIndex < NVIC_PRI_REG_COUNT; RegIndex++) {
+        NVIC_WRITE32(NVIC_PRI_ADDR(RegIndex), State->Priority[RegIndex]);
+    }
+    for (RegIndex = 0; RegIndex < NVIC_SYSPRI_REG_COUNT; RegIndex++) {
+        NVIC_WRITE32(NVIC_SYSTEM_PRI_ADDR(RegIndex), State->SysPriority[RegIndex]);
+    }
+    NVIC_WRITE32(NVIC_SYSTEM_SYSHNDCTRL_ADDR,
+                 (NVIC_READ32(NVIC_SYSTEM_SYSHNDCTRL_ADDR) & ~(uint32)SYSHNDCTRL_ENABLE_MASK) |
+                 (State->SysHndCtrl & SYSHNDCTRL_ENABLE_MASK));
+    for (RegIndex = 0; RegIndex < NVIC_IRQ_REG_COUNT; RegIndex++) {
+        NVIC_WRITE32(NVIC_DIS_ADDR(RegIndex), ~State->Enable[RegIndex]);
+        NVIC_WRITE32(NVIC_EN_ADDR(RegIndex), State->Enable[RegIndex]);
+    }
+#if NVIC_SHADOW_ENABLE
+    for (RegIndex = 0; RegIndex < NVIC_PRI_REG_COUNT; RegIndex++) {
+        NVIC_Shadow.Priority.Words[RegIndex] = State->Priority[RegIndex];
+    }
+    for (RegIndex = 0; RegIndex < NVIC_SYSPRI_REG_COUNT; RegIndex++) {
+        NVIC_Shadow.SysPriority.Words[RegIndex] = State->SysPriority[RegIndex];
+    }
+    /* The registers now hold the snapshot: changes coalesced by an open update
+     * before the restore are dropped, NVIC_CommitUpdate only writes later ones */
+    for (RegIndex = 0; RegIndex < (NVIC_PRI_REG_COUNT + 31U) / 32U; RegIndex++) {
+        NVIC_Shadow.PriorityDirty[RegIndex] = 0;
+    }
+    NVIC_Shadow.SysPriorityDirty = 0;
+    NVIC_Shadow.SysHndCtrl = State->SysHndCtrl & SYSHNDCTRL_ENABLE_MASK;
+    NVIC_Shadow.HwSysHndCtrl = NVIC_Shadow.SysHndCtrl;
+    for (RegIndex = 0; RegIndex < NVIC_IRQ_REG_COUNT; RegIndex++) {
+        NVIC_Shadow.Enable[RegIndex] = State->Enable[RegIndex];
+        NVIC_Shadow.HwEnable[RegIndex] = State->Enable[RegIndex];
+    }
+#endif
+    NVIC_EXIT_CRITICAL(Saved);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_RestoreStateChanged
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): State - Snapshot taken by NVIC_SaveState
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to bring the NVIC back to a snapshot storing only the
+ *              words that differ from the current state, and only the changed
+ *              bits of the ENn/DISn words. Priorities are restored before the enables
+ **********************************************************************/
+void NVIC_RestoreStateChanged(const NVIC_StateType *State) {
+    uint32 RegIndex;
+    uint32 Current;
+    if (State == NULL_PTR) {
+        return;
+    }
+    for (RegIndex = 0; RegIndex < NVIC_PRI_REG_COUNT; RegIndex++) {
+        if (NVIC_CurrentPriorityWord(RegIndex) != State->Priority[RegIndex]) {
+            NVIC_UpdatePriorityWord(RegIndex, State->Priority[RegIndex]);
+        }
+    }
+    for (RegIndex = 0; RegIndex < NVIC_SYSPRI_REG_COUNT; RegIndex++) {
+        if (NVIC_CurrentSysPriorityWord(RegIndex) != State->SysPriority[RegIndex]) {
+            NVIC_UpdateSysPriority(RegIndex, 0xFFFFFFFFUL, State->SysPriority[RegIndex]);
+        }
+    }
+    Current = NVIC_CurrentSysHndCtrl();
+    if (Current != (State->SysHndCtrl & SYSHNDCTRL_ENABLE_MASK)) {
+        NVIC_UpdateSysHndCtrl(State->SysHndCtrl & ~Current & SYSHNDCTRL_ENABLE_MASK,
+                              Current & ~State->SysHndCtrl);
+    }
+    for (RegIndex = 0; RegIndex < NVIC_IRQ_REG_COUNT; RegIndex++) {
+        Current = NVIC_CurrentEnableWord(RegIndex);
+        if (Current != State->Enable[RegIndex]) {
+            NVIC_UpdateEnableWord(RegIndex, State->Enable[RegIndex] & ~Current, Current & ~State->Enable[RegIndex]);
+        }
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_SetPriorityGrouping
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Priority_Group - Split of the priority bits into preemption/sub-priority
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to program APINT.PRIGROUP. Must be called before the
+ *              grouped priorities are assigned and before the IRQs are enabled
+ **********************************************************************/
+void NVIC_SetPriorityGrouping(NVIC_PriorityGroupType Priority_Group) {
+    if ((Priority_Group < NVIC_PRIGROUP_ALL_PREEMPT) || (Priority_Group > NVIC_PRIGROUP_NO_PREEMPT)) {
+        Priority_Group = NVIC_PRIGROUP_ALL_PREEMPT;
+    }
+    /* The other APINT bits are written as zero: no reset request, no VECTCLRACT */
+    NVIC_WRITE32(NVIC_SYSTEM_APINT_ADDR, APINT_VECTKEY | ((uint32)Priority_Group << APINT_PRIGROUP_BITS_POS));
+}
+
+/*********************************************************************
+ * Service Name: NVIC_GetPriorityGrouping
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_PriorityGroupType - Current priority grouping
+ * Description: Function to read APINT.PRIGROUP. The lower values, such as the
+ *              reset value, are returned as NVIC_PRIGROUP_ALL_PREEMPT, which they
+ *              behave as
+ **********************************************************************/
+NVIC_PriorityGroupType NVIC_GetPriorityGrouping(void) {
+    uint32 Group = (NVIC_READ32(NVIC_SYSTEM_APINT_ADDR) & APINT_PRIGROUP_MASK) >> APINT_PRIGROUP_BITS_POS;
+    if (Group < (uint32)NVIC_PRIGROUP_ALL_PREEMPT) {
+        Group = (uint32)NVIC_PRIGROUP_ALL_PREEMPT;
+    }
+    return (NVIC_PriorityGroupType)Group;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_SetGroupedPriorityIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ *                  Preempt_Priority - Preemption priority of the IRQ
+ *                  Sub_Priority - Sub-priority of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set the priority of an IRQ as a (preempt, sub) pair
+ *              under the current priority grouping
+ **********************************************************************/
+void NVIC_SetGroupedPriorityIRQ(NVIC_IRQType IRQ_Num, uint8 Preempt_Priority, uint8 Sub_Priority) {
+    NVIC_SetPriorityIRQ(IRQ_Num, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), Preempt_Priority, Sub_Priority));
+}
+
+/*********************************************************************
+ * Service Name: NVIC_SetGroupedPriorityException
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Number of the exception from the system control block
+ *                  Preempt_Priority - Preemption priority of the exception
+ *                  Sub_Priority - Sub-priority of the exception
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set the priority of an exception as a (preempt, sub)
+ *              pair under the current priority grouping
+ **********************************************************************/
+void NVIC_SetGroupedPriorityException(NVIC_ExceptionType Exception_Num, uint8 Preempt_Priority, uint8 Sub_Priority) {
+    NVIC_SetPriorityException(Exception_Num,
+                              (NVIC_ExceptionPriorityType)NVIC_EncodePriority(NVIC_GetPriorityGrouping(), Preempt_Priority, Sub_Priority));
+}
+
+/*********************************************************************
+ * Service Name: NVIC_RelocateVectorTable
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Flash_Table - Vector table of the startup code (NVIC_VECTOR_COUNT entries)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to copy the vector table into the driver RAM table and
+ *              point VTABLE at it, after which handlers can be swapped at runtime
+ **********************************************************************/
+void NVIC_RelocateVectorTable(const NVIC_HandlerType *Flash_Table) {
+    uint32 Vector;
+    if ((Flash_Table == NULL_PTR) || (Flash_Table == (const NVIC_HandlerType *)NVIC_RamVectorTable)) {
+        return;
+    }
+    for (Vector = 0; Vector < NVIC_VECTOR_COUNT; Vector++) {
+        NVIC_RamVectorTable[Vector] = Flash_Table[Vector];
+    }
+    NVIC_DSB();
+    NVIC_SET_VTABLE(NVIC_RamVectorTable);
+    NVIC_DSB();
+}
+
+/*********************************************************************
+ * Service Name: NVIC_SetExceptionHandler
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Number of the exception from the system control block
+ *                  Handler - New handler of the exception
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to install a system exception handler in the RAM vector
+ *              table. Reset is ignored, it is only fetched from the boot table
+ **********************************************************************/
+void NVIC_SetExceptionHandler(NVIC_ExceptionType Exception_Num, NVIC_HandlerType Handler) {
+    if ((Exception_Num == EXCEPTION_RESET_TYPE) || (Exception_Num > EXCEPTION_SYSTICK_TYPE)) {
+        return;
+    }
+    NVIC_RamVectorTable[NVIC_ExceptionVector[Exception_Num]] = Handler;
+    NVIC_DSB();
+}
@@ -1,279 +1,924 @@
-/******************************************************************************
- *
- * Module: NVIC
- *
- * File Name: NVIC.h
- *
- * Description: Header file for the ARM Cortex M4 NVIC driver
- *
- * Author: Mohamed Hisham
- *
- *******************************************************************************/
-
-#ifndef NVIC_H_
-#define NVIC_H_
-
-/*******************************************************************************
- * INCLUSIONS                                                                  *
- *******************************************************************************/
-#include "std_types.h"
-
-/*******************************************************************************
- * PREPROCESSOR DEFINITIONS                                                    *
- *******************************************************************************/
-
-#define MEM_FAULT_PRIORITY_MASK              0x000000E0
-#define MEM_FAULT_PRIORITY_BITS_POS          5
-
-#define BUS_FAULT_PRIORITY_MASK              0x0000E000
-#define BUS_FAULT_PRIORITY_BITS_POS          13
-
-#define USAGE_FAULT_PRIORITY_MASK            0x00E00000
-#define USAGE_FAULT_PRIORITY_BITS_POS        21
-
-#define SVC_PRIORITY_MASK                    0xE0000000
-#define SVC_PRIORITY_BITS_POS                29
-
-#define DEBUG_MONITOR_PRIORITY_MASK          0x000000E0
-#define DEBUG_MONITOR_PRIORITY_BITS_POS      5
-
-#define PENDSV_PRIORITY_MASK                 0x00E00000
-#define PENDSV_PRIORITY_BITS_POS             21
-
-#define SYSTICK_PRIORITY_MASK                0xE0000000
-#define SYSTICK_PRIORITY_BITS_POS            29
-
-#define MEM_FAULT_ENABLE_MASK                0x00010000
-#define BUS_FAULT_ENABLE_MASK                0x00020000
-#define USAGE_FAULT_ENABLE_MASK              0x00040000
-
-#define NVIC_PRI0_REG_ONE_BYTE             (((volatile uint8 *)0xE000E400))
-
-/* Macro to access the NVIC Registers with the offset from base address */
-#define NVIC_REG(base, offset)            (*((volatile uint32 *)((base) + (offset))))
-
-/* Enable Exceptions ... This Macro enable IRQ interrupts, Programmable Systems Exceptions and Faults by clearing the I-bit in the PRIMASK. */
-#define Enable_Exceptions()    __asm(" CPSIE I ")
-
-/* Disable Exceptions ... This Macro disable IRQ interrupts, Programmable Systems Exceptions and Faults by setting the I-bit in the PRIMASK. */
-#define Disable_Exceptions()   __asm(" CPSID I ")
-
-/* Enable Faults ... This Macro enable Faults by clearing the F-bit in the FAULTMASK */
-#define Enable_Faults()        __asm(" CPSIE F ")
-
-/* Disable Faults ... This Macro disable Faults by setting the F-bit in the FAULTMASK */
-#define Disable_Faults()       __asm(" CPSID F ")
-
-/*******************************************************************************
- * DATA TYPES DDECLERATIONS                                                    *
- *******************************************************************************/
-typedef enum {
-    NVIC_IRQ_GPIO_PORTA = 0,         // Interrupt 16: GPIO Port A
-    NVIC_IRQ_GPIO_PORTB = 1,         // Interrupt 17: GPIO Port B
-    NVIC_IRQ_GPIO_PORTC = 2,         // Interrupt 18: GPIO Port C
-    NVIC_IRQ_GPIO_PORTD = 3,         // Interrupt 19: GPIO Port D
-    NVIC_IRQ_GPIO_PORTE = 4,         // Interrupt 20: GPIO Port E
-    NVIC_IRQ_UART0 = 5,              // Interrupt 21: UART0
-    NVIC_IRQ_UART1 = 6,              // Interrupt 22: UART1
-    NVIC_IRQ_SSI0 = 7,               // Interrupt 23: SSI0
-    NVIC_IRQ_I2C0 = 8,               // Interrupt 24: I2C0
-    NVIC_IRQ_PWM0_FAULT = 9,         // Interrupt 25: PWM0 Fault
-    NVIC_IRQ_PWM0_GEN0 = 10,         // Interrupt 26: PWM0 Generator 0
-    NVIC_IRQ_PWM0_GEN1 = 11,         // Interrupt 27: PWM0 Generator 1
-    NVIC_IRQ_PWM0_GEN2 = 12,         // Interrupt 28: PWM0 Generator 2
-    NVIC_IRQ_QEI0 = 13,              // Interrupt 29: QEI0
-    NVIC_IRQ_ADC0_SEQ0 = 14,         // Interrupt 30: ADC0 Sequence 0
-    NVIC_IRQ_ADC0_SEQ1 = 15,         // Interrupt 31: ADC0 Sequence 1
-    NVIC_IRQ_ADC0_SEQ2 = 16,         // Interrupt 32: ADC0 Sequence 2
-    NVIC_IRQ_ADC0_SEQ3 = 17,         // Interrupt 33: ADC0 Sequence 3
-    NVIC_IRQ_WATCHDOG = 18,          // Interrupt 34: Watchdog Timers 0 and 1
-    NVIC_IRQ_TIMER0A = 19,           // Interrupt 35: 16/32-Bit Timer 0A
-    NVIC_IRQ_TIMER0B = 20,           // Interrupt 36: 16/32-Bit Timer 0B
-    NVIC_IRQ_TIMER1A = 21,           // Interrupt 37: 16/32-Bit Timer 1A
-    NVIC_IRQ_TIMER1B = 22,           // Interrupt 38: 16/32-Bit Timer 1B
-    NVIC_IRQ_TIMER2A = 23,           // Interrupt 39: 16/32-Bit Timer 2A
-    NVIC_IRQ_TIMER2B = 24,           // Interrupt 40: 16/32-Bit Timer 2B
-    NVIC_IRQ_COMP0 = 25,             // Interrupt 41: Analog Comparator 0
-    NVIC_IRQ_COMP1 = 26,             // Interrupt 42: Analog Comparator 1
-    // Reserved 27
-    NVIC_IRQ_SYSCTL = 28,            // Interrupt 44: System Control
-    NVIC_IRQ_FLASH = 29,             // Interrupt 45: Flash Memory Control and EEPROM Control
-    NVIC_IRQ_GPIO_PORTF = 30,        // Interrupt 46: GPIO Port F
-    // Reserved 31-32
-    NVIC_IRQ_UART2 = 33,             // Interrupt 49: UART2
-    NVIC_IRQ_SSI1 = 34,              // Interrupt 50: SSI1
-    NVIC_IRQ_TIMER3A = 35,           // Interrupt 51: 16/32-Bit Timer 3A
-    NVIC_IRQ_TIMER3B = 36,           // Interrupt 52: 16/32-Bit Timer 3B
-    NVIC_IRQ_I2C1 = 37,              // Interrupt 53: I2C1
-    NVIC_IRQ_QEI1 = 38,              // Interrupt 54: QEI1
-    NVIC_IRQ_CAN0 = 39,              // Interrupt 55: CAN0
-    NVIC_IRQ_CAN1 = 40,              // Interrupt 56: CAN1
-    // Reserved 41-42
-    NVIC_IRQ_HIBERNATION = 43,       // Interrupt 59: Hibernation Module
-    NVIC_IRQ_USB = 44,               // Interrupt 60: USB
-    NVIC_IRQ_PWM_GEN3 = 45,          // Interrupt 61: PWM Generator 3
-    NVIC_IRQ_UDMA_SW = 46,           // Interrupt 62: uDMA Software
-    NVIC_IRQ_UDMA_ERR = 47,          // Interrupt 63: uDMA Error
-    NVIC_IRQ_ADC1_SEQ0 = 48,         // Interrupt 64: ADC1 Sequence 0
-    NVIC_IRQ_ADC1_SEQ1 = 49,         // Interrupt 65: ADC1 Sequence 1
-    NVIC_IRQ_ADC1_SEQ2 = 50,         // Interrupt 66: ADC1 Sequence 2
-    NVIC_IRQ_ADC1_SEQ3 = 51,         // Interrupt 67: ADC1 Sequence 3
-    // Reserved 52-56
-    NVIC_IRQ_SSI2 = 57,              // Interrupt 73: SSI2
-    NVIC_IRQ_SSI3 = 58,              // Interrupt 74: SSI3
-    NVIC_IRQ_UART3 = 59,             // Interrupt 75: UART3
-    NVIC_IRQ_UART4 = 60,             // Interrupt 76: UART4
-    NVIC_IRQ_UART5 = 61,             // Interrupt 77: UART5
-    NVIC_IRQ_UART6 = 62,             // Interrupt 78: UART6
-    NVIC_IRQ_UART7 = 63,             // Interrupt 79: UART7
-    // Reserved 64-67
-    NVIC_IRQ_I2C2 = 68,              // Interrupt 84: I2C2
-    NVIC_IRQ_I2C3 = 69,              // Interrupt 85: I2C3
-    NVIC_IRQ_TIMER4A = 70,           // Interrupt 86: 16/32-Bit Timer 4A
-    NVIC_IRQ_TIMER4B = 71,           // Interrupt 87: 16/32-Bit Timer 4B
-    // Reserved 72-91
-    NVIC_IRQ_TIMER5A = 92,           // Interrupt 108: 16/32-Bit Timer 5A
-    NVIC_IRQ_TIMER5B = 93,           // Interrupt 109: 16/32-Bit Timer 5B
-    NVIC_IRQ_TIMER0A_64 = 94,        // Interrupt 110: 32/64-Bit Timer 0A
-    NVIC_IRQ_TIMER0B_64 = 95,        // Interrupt 111: 32/64-Bit Timer 0B
-    NVIC_IRQ_TIMER1A_64 = 96,        // Interrupt 112: 32/64-Bit Timer 1A
-    NVIC_IRQ_TIMER1B_64 = 97,        // Interrupt 113: 32/64-Bit Timer 1B
-    NVIC_IRQ_TIMER2A_64 = 98,        // Interrupt 114: 32/64-Bit Timer 2A
-    NVIC_IRQ_TIMER2B_64 = 99,        // Interrupt 115: 32/64-Bit Timer 2B
-    NVIC_IRQ_TIMER3A_64 = 100,       // Interrupt 116: 32/64-Bit Timer 3A
-    NVIC_IRQ_TIMER3B_64 = 101,       // Interrupt 117: 32/64-Bit Timer 3B
-    NVIC_IRQ_TIMER4A_64 = 102,       // Interrupt 118: 32/64-Bit Timer 4A
-    NVIC_IRQ_TIMER4B_64 = 103,       // Interrupt 119: 32/64-Bit Timer 4B
-    NVIC_IRQ_TIMER5A_64 = 104,       // Interrupt 120: 32/64-Bit Timer 5A
-    NVIC_IRQ_TIMER5B_64 = 105,       // Interrupt 121: 32/64-Bit Timer 5B
-    NVIC_IRQ_SYSTEM_EXCEPTION = 106, // Interrupt 122: System Exception (imprecise)
-    // Reserved 107-133
-    NVIC_IRQ_PWM1_GEN0 = 134,        // Interrupt 150: PWM1 Generator 0
-    NVIC_IRQ_PWM1_GEN1 = 135,        // Interrupt 151: PWM1 Generator 1
-    NVIC_IRQ_PWM1_GEN2 = 136,        // Interrupt 152: PWM1 Generator 2
-    NVIC_IRQ_PWM1_GEN3 = 137,        // Interrupt 153: PWM1 Generator 3
-    NVIC_IRQ_PWM1_FAULT = 138,       // Interrupt 154: PWM1 Fault
-} NVIC_IRQType;
-
-typedef enum {
-    NVIC_PRIORITY_0 = 0,
-    NVIC_PRIORITY_1 = 1,
-    NVIC_PRIORITY_2 = 2,
-    NVIC_PRIORITY_3 = 3,
-    NVIC_PRIORITY_4 = 4,
-    NVIC_PRIORITY_5 = 5,
-    NVIC_PRIORITY_6 = 6,
-    NVIC_PRIORITY_7 = 7,
-} NVIC_IRQPriorityType;
-
-typedef enum
-{
-    EXCEPTION_RESET_TYPE,
-    EXCEPTION_NMI_TYPE,
-    EXCEPTION_HARD_FAULT_TYPE,
-    EXCEPTION_MEM_FAULT_TYPE,
-    EXCEPTION_BUS_FAULT_TYPE,
-    EXCEPTION_USAGE_FAULT_TYPE,
-    EXCEPTION_SVC_TYPE,
-    EXCEPTION_DEBUG_MONITOR_TYPE,
-    EXCEPTION_PEND_SV_TYPE,
-    EXCEPTION_SYSTICK_TYPE
-}NVIC_ExceptionType;
-
-typedef enum {
-    NVIC_EXCEPTION_PRIORITY_0 = 0,
-    NVIC_EXCEPTION_PRIORITY_1 = 1,
-    NVIC_EXCEPTION_PRIORITY_2 = 2,
-    NVIC_EXCEPTION_PRIORITY_3 = 3,
-    NVIC_EXCEPTION_PRIORITY_4 = 4,
-    NVIC_EXCEPTION_PRIORITY_5 = 5,
-    NVIC_EXCEPTION_PRIORITY_6 = 6,
-    NVIC_EXCEPTION_PRIORITY_7 = 7,
-} NVIC_ExceptionPriorityType;
-
-/*******************************************************************************
- * FUNCTION PROTOTYPES                                                         *
- *******************************************************************************/
-
- /*********************************************************************
-  * Service Name: NVIC_EnableIRQ
-  * Sync/Async: Synchronous
-  * Reentrancy: Reentrant
-  * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
-  * Parameters (inout): None
-  * Parameters (out): None
-  * Return value: None
-  * Description: Function to enable Interrupt request for specific IRQ
-  **********************************************************************/
-void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num);
-
-/*********************************************************************
- * Service Name: NVIC_DisableIRQ
- * Sync/Async: Synchronous
- * Reentrancy: Reentrant
- * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Function to disable Interrupt request for specific IRQ
- **********************************************************************/
-void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num);
-
-/*********************************************************************
- * Service Name: NVIC_SetPriorityIRQ
- * Sync/Async: Synchronous
- * Reentrancy: Reentrant
- * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
- *                  IRQ_Priority - Priority value for the IRQ
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Function to set the priority value for specific IRQ
- **********************************************************************/
-void NVIC_SetPriorityIRQ(NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType IRQ_Priority);
-
-/*********************************************************************
- * Service Name: NVIC_EnableException
- * Sync/Async: Synchronous
- * Reentrancy: Reentrant
- * Parameters (in): Exception_Num - Number of the exception from the system control block
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Function to enable specific ARM system or fault exceptions
- **********************************************************************/
-void NVIC_EnableException(NVIC_ExceptionType Exception_Num);
-
-
-/*********************************************************************
- * Service Name: NVIC_DisableException
- * Sync/Async: Synchronous
- * Reentrancy: Reentrant
- * Parameters (in): Exception_Num - Number of the exception from the system control block
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Function to disable specific ARM system or fault exceptions
- **********************************************************************/
-void NVIC_DisableException(NVIC_ExceptionType Exception_Num);
-
-/*********************************************************************
- * Service Name: NVIC_SetPriorityException
- * Sync/Async: Synchronous
- * Reentrancy: Reentrant
- * Parameters (in): Exception_Num - Number of the exception from the system control block
- *                  Exception_Priority - Priority value for the exception
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Function to set the priority value for specific ARM system or fault exceptions
- **********************************************************************/
-void NVIC_SetPriorityException(NVIC_ExceptionType Exception_Num, NVIC_ExceptionPriorityType Exception_Priority);
-
-
-
-/************************************************************************************
- *                                 End of File                                      *
- ************************************************************************************/
-
-#endif /* NVIC_H_ */
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC.h
+ *
+ * Description: Header file for the ARM Cortex M4 NVIC driver
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_H_
+#define NVIC_H_
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+#include "std_types.h"
+#include "NVIC_Regs.h"
+#include "NVIC_Cfg.h"
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+/* Priority field positions inside SYSPRI1-SYSPRI3, the implemented bits sit at the top of each byte */
+#define MEM_FAULT_PRIORITY_BITS_POS          (0U + NVIC_PRIORITY_BITS_POS)
+#define MEM_FAULT_PRIORITY_MASK              (NVIC_PRIORITY_MAX << MEM_FAULT_PRIORITY_BITS_POS)
+
+#define BUS_FAULT_PRIORITY_BITS_POS          (8U + NVIC_PRIORITY_BITS_POS)
+#define BUS_FAULT_PRIORITY_MASK              (NVIC_PRIORITY_MAX << BUS_FAULT_PRIORITY_BITS_POS)
+
+#define USAGE_FAULT_PRIORITY_BITS_POS        (16U + NVIC_PRIORITY_BITS_POS)
+#define USAGE_FAULT_PRIORITY_MASK            (NVIC_PRIORITY_MAX << USAGE_FAULT_PRIORITY_BITS_POS)
+
+#define SVC_PRIORITY_BITS_POS                (24U + NVIC_PRIORITY_BITS_POS)
+#define SVC_PRIORITY_MASK                    (NVIC_PRIORITY_MAX << SVC_PRIORITY_BITS_POS)
+
+#define DEBUG_MONITOR_PRIORITY_BITS_POS      (0U + NVIC_PRIORITY_BITS_POS)
+#define DEBUG_MONITOR_PRIORITY_MASK          (NVIC_PRIORITY_MAX << DEBUG_MONITOR_PRIORITY_BITS_POS)
+
+#define PENDSV_PRIORITY_BITS_POS             (16U + NVIC_PRIORITY_BITS_POS)
+#define PENDSV_PRIORITY_MASK                 (NVIC_PRIORITY_MAX << PENDSV_PRIORITY_BITS_POS)
+
+#define SYSTICK_PRIORITY_BITS_POS            (24U + NVIC_PRIORITY_BITS_POS)
+#define SYSTICK_PRIORITY_MASK                (NVIC_PRIORITY_MAX << SYSTICK_PRIORITY_BITS_POS)
+
+#define MEM_FAULT_ENABLE_MASK                0x00010000
+#define BUS_FAULT_ENABLE_MASK                0x00020000
+#define USAGE_FAULT_ENABLE_MASK              0x00040000
+#define DEBUG_MONITOR_ENABLE_MASK            0x00000100
+
+/* Exception enable bits of SYSHNDCTRL, the other bits are live active/pending status */
+#define SYSHNDCTRL_ENABLE_MASK               (MEM_FAULT_ENABLE_MASK | BUS_FAULT_ENABLE_MASK | \
+                                              USAGE_FAULT_ENABLE_MASK | DEBUG_MONITOR_ENABLE_MASK)
+
+/* CFGCTRL.MAINPEND lets unprivileged code write SWTRIG */
+#define CFGCTRL_MAINPEND_MASK                0x00000002
+
+/* SWTRIG.INTID, the IRQ number to pend */
+#define SWTRIG_INTID_MASK                    0x000000FF
+
+#define APINT_VECTKEY                        0x05FA0000
+#define APINT_PRIGROUP_MASK                  0x00000700
+#define APINT_PRIGROUP_BITS_POS              8
+
+#define INTCTRL_PENDSV_SET_MASK              0x10000000
+#define INTCTRL_PENDSV_CLEAR_MASK            0x08000000
+
+/* Implemented priority bits, the lowest priority level and their position inside each 8-bit PRIn field */
+#define NVIC_PRIORITY_BITS                   NVIC_DEVICE_PRIORITY_BITS
+#define NVIC_PRIORITY_MAX                    ((1UL << NVIC_PRIORITY_BITS) - 1UL)
+#define NVIC_PRIORITY_BITS_POS               (8U - NVIC_PRIORITY_BITS)
+
+/* Vector table: 16 system exception vectors (entry 0 is the initial stack pointer) followed by the IRQs */
+#define NVIC_IRQ_VECTOR_OFFSET               16U
+#define NVIC_VECTOR_COUNT                    (NVIC_IRQ_VECTOR_OFFSET + NVIC_IRQ_COUNT)
+
+/* VTABLE needs the table aligned to its size rounded up to a power of two, 128 bytes at least */
+#define NVIC_VECTOR_TABLE_BYTES              (NVIC_VECTOR_COUNT * 4U)
+#define NVIC_VECTOR_TABLE_ALIGNMENT          ((NVIC_VECTOR_TABLE_BYTES <= 128U) ? 128U :    \
+                                              (NVIC_VECTOR_TABLE_BYTES <= 256U) ? 256U :    \
+                                              (NVIC_VECTOR_TABLE_BYTES <= 512U) ? 512U : 1024U)
+
+/* Priority field of an IRQ placed at its byte lane inside its PRIn register */
+#define NVIC_PRI_FIELD(IRQ_Num, Priority)    ((uint32)(Priority) << ((((uint32)(IRQ_Num) & 3UL) << 3) + NVIC_PRIORITY_BITS_POS))
+
+/* Macro to access the NVIC Registers with the offset from base address */
+#define NVIC_REG(base, offset)            (*((volatile uint32 *)((base) + (offset))))
+
+/* Register word and bit of an IRQ inside the ENn/DISn registers and NVIC_IRQMaskType */
+#define NVIC_IRQ_WORD(IRQ_Num)            ((uint32)(IRQ_Num) >> 5)
+#define NVIC_IRQ_BIT(IRQ_Num)             (1UL << ((uint32)(IRQ_Num) & 31UL))
+
+/* TRUE if IRQ_Num is implemented and not reserved on the selected part, a constant
+ * expression when IRQ_Num is a constant */
+#define NVIC_IRQ_IS_VALID(IRQ_Num)                                              \
+    (((uint32)(IRQ_Num) < NVIC_IRQ_COUNT) &&                                    \
+     ((NVIC_DEVICE_VALID_IRQ_WORD(NVIC_IRQ_WORD(IRQ_Num)) & NVIC_IRQ_BIT(IRQ_Num)) != 0UL))
+
+/* IRQ_Num checked at build time: wrap constant IRQ numbers passed to the driver,
+ * e.g. NVIC_EnableIRQ(NVIC_STATIC_IRQ(NVIC_IRQ_UART0)). A reserved or out-of-range
+ * number fails the static_assert of NVIC_StaticIRQ in C++, and gives a negative
+ * bit-field width in C, where a non-constant one gives a non-constant width */
+#ifdef __cplusplus
+#define NVIC_STATIC_IRQ(IRQ_Num)             (NVIC_StaticIRQ<(uint32)(IRQ_Num)>::Value)
+#else
+#define NVIC_STATIC_IRQ(IRQ_Num)                                                \
+    ((NVIC_IRQType)((IRQ_Num) + (0U * sizeof(struct { unsigned int NVIC_ReservedIRQ : (NVIC_IRQ_IS_VALID(IRQ_Num) ? 1 : -1); }))))
+#endif
+
+/* Add/remove an IRQ to/from a NVIC_IRQMaskType */
+#define NVIC_IRQ_MASK_ADD(Mask, IRQ_Num)     ((Mask).Words[NVIC_IRQ_WORD(IRQ_Num)] |= NVIC_IRQ_BIT(IRQ_Num))
+#define NVIC_IRQ_MASK_REMOVE(Mask, IRQ_Num)  ((Mask).Words[NVIC_IRQ_WORD(IRQ_Num)] &= ~NVIC_IRQ_BIT(IRQ_Num))
+
+#ifdef NVIC_HOST_SIM
+
+/* Host stand-ins for the PRIMASK/FAULTMASK instructions when running against the register simulator */
+#define Enable_Exceptions()    NVIC_Sim_SetPrimask(0U)
+#define Disable_Exceptions()   NVIC_Sim_SetPrimask(1U)
+#define Enable_Faults()        NVIC_Sim_SetFaultmask(0U)
+#define Disable_Faults()       NVIC_Sim_SetFaultmask(1U)
+
+#else
+
+/* Enable Exceptions ... This Macro enable IRQ interrupts, Programmable Systems Exceptions and Faults by clearing the I-bit in the PRIMASK. */
+#define Enable_Exceptions()    __asm(" CPSIE I ")
+
+/* Disable Exceptions ... This Macro disable IRQ interrupts, Programmable Systems Exceptions and Faults by setting the I-bit in the PRIMASK. */
+#define Disable_Exceptions()   __asm(" CPSID I ")
+
+/* Enable Faults ... This Macro enable Faults by clearing the F-bit in the FAULTMASK */
+#define Enable_Faults()        __asm(" CPSIE F ")
+
+/* Disable Faults ... This Macro disable Faults by setting the F-bit in the FAULTMASK */
+#define Disable_Faults()       __asm(" CPSID F ")
+
+#endif /* NVIC_HOST_SIM */
+
+/*******************************************************************************
+ * DATA TYPES DDECLERATIONS                                                    *
+ *******************************************************************************/
+typedef enum {
+    NVIC_PRIORITY_0 = 0,
+    NVIC_PRIORITY_1 = 1,
+    NVIC_PRIORITY_2 = 2,
+    NVIC_PRIORITY_3 = 3,
+    NVIC_PRIORITY_4 = 4,
+    NVIC_PRIORITY_5 = 5,
+    NVIC_PRIORITY_6 = 6,
+    NVIC_PRIORITY_7 = 7,
+#if (NVIC_PRIORITY_BITS == 4U)
+    NVIC_PRIORITY_8 = 8,
+    NVIC_PRIORITY_9 = 9,
+    NVIC_PRIORITY_10 = 10,
+    NVIC_PRIORITY_11 = 11,
+    NVIC_PRIORITY_12 = 12,
+    NVIC_PRIORITY_13 = 13,
+    NVIC_PRIORITY_14 = 14,
+    NVIC_PRIORITY_15 = 15,
+#endif
+} NVIC_IRQPriorityType;
+
+typedef enum
+{
+    EXCEPTION_RESET_TYPE,
+    EXCEPTION_NMI_TYPE,
+    EXCEPTION_HARD_FAULT_TYPE,
+    EXCEPTION_MEM_FAULT_TYPE,
+    EXCEPTION_BUS_FAULT_TYPE,
+    EXCEPTION_USAGE_FAULT_TYPE,
+    EXCEPTION_SVC_TYPE,
+    EXCEPTION_DEBUG_MONITOR_TYPE,
+    EXCEPTION_PEND_SV_TYPE,
+    EXCEPTION_SYSTICK_TYPE
+}NVIC_ExceptionType;
+
+typedef enum {
+    NVIC_EXCEPTION_PRIORITY_0 = 0,
+    NVIC_EXCEPTION_PRIORITY_1 = 1,
+    NVIC_EXCEPTION_PRIORITY_2 = 2,
+    NVIC_EXCEPTION_PRIORITY_3 = 3,
+    NVIC_EXCEPTION_PRIORITY_4 = 4,
+    NVIC_EXCEPTION_PRIORITY_5 = 5,
+    NVIC_EXCEPTION_PRIORITY_6 = 6,
+    NVIC_EXCEPTION_PRIORITY_7 = 7,
+#if (NVIC_PRIORITY_BITS == 4U)
+    NVIC_EXCEPTION_PRIORITY_8 = 8,
+    NVIC_EXCEPTION_PRIORITY_9 = 9,
+    NVIC_EXCEPTION_PRIORITY_10 = 10,
+    NVIC_EXCEPTION_PRIORITY_11 = 11,
+    NVIC_EXCEPTION_PRIORITY_12 = 12,
+    NVIC_EXCEPTION_PRIORITY_13 = 13,
+    NVIC_EXCEPTION_PRIORITY_14 = 14,
+    NVIC_EXCEPTION_PRIORITY_15 = 15,
+#endif
+} NVIC_ExceptionPriorityType;
+
+/* One entry of a priority table applied with NVIC_ApplyPriorityTable */
+typedef struct {
+    NVIC_IRQType IRQ_Num;
+    NVIC_IRQPriorityType IRQ_Priority;
+} NVIC_IRQPriorityConfigType;
+
+/* Split of the implemented priority bits into preemption.sub-priority bits,
+ * the value is the APINT.PRIGROUP field. Lower PRIGROUP values behave as
+ * NVIC_PRIGROUP_ALL_PREEMPT */
+typedef enum {
+#if (NVIC_PRIORITY_BITS == 3U)
+    NVIC_PRIGROUP_3_0 = 4,      /* 8 preemption levels, no sub-priority      */
+    NVIC_PRIGROUP_2_1 = 5,      /* 4 preemption levels, 2 sub-priorities     */
+    NVIC_PRIGROUP_1_2 = 6,      /* 2 preemption levels, 4 sub-priorities     */
+    NVIC_PRIGROUP_0_3 = 7,      /* No preemption, 8 sub-priorities           */
+#else
+    NVIC_PRIGROUP_4_0 = 3,      /* 16 preemption levels, no sub-priority     */
+    NVIC_PRIGROUP_3_1 = 4,      /* 8 preemption levels, 2 sub-priorities     */
+    NVIC_PRIGROUP_2_2 = 5,      /* 4 preemption levels, 4 sub-priorities     */
+    NVIC_PRIGROUP_1_3 = 6,      /* 2 preemption levels, 8 sub-priorities     */
+    NVIC_PRIGROUP_0_4 = 7,      /* No preemption, 16 sub-priorities          */
+#endif
+} NVIC_PriorityGroupType;
+
+/* First (all bits preempt) and last (no preemption) grouping of the part */
+#define NVIC_PRIGROUP_ALL_PREEMPT            ((NVIC_PriorityGroupType)(7U - NVIC_PRIORITY_BITS))
+#define NVIC_PRIGROUP_NO_PREEMPT             ((NVIC_PriorityGroupType)7U)
+
+/* Interrupt/exception handler as stored in the vector table */
+typedef void (*NVIC_HandlerType)(void);
+
+/* Saved BASEPRI value returned by NVIC_RaiseThreshold */
+typedef uint8 NVIC_ThresholdType;
+
+/* Set of IRQs, one bit per IRQ number, laid out like the ENn/DISn registers */
+typedef struct {
+    uint32 Words[NVIC_IRQ_REG_COUNT];
+} NVIC_IRQMaskType;
+
+/* IRQs covered by a NVIC_MaskSet scope, handed back to NVIC_UnmaskSet */
+typedef NVIC_IRQMaskType NVIC_MaskTokenType;
+
+/* Snapshot of the interrupt configuration taken by NVIC_SaveState. Plain words
+ * with no pointers, so it can be kept in retained RAM */
+typedef struct {
+    uint32 Enable[NVIC_IRQ_REG_COUNT];          /* EN0-ENn                          */
+    uint32 Priority[NVIC_PRI_REG_COUNT];        /* PRI0-PRIn                        */
+    uint32 SysPriority[NVIC_SYSPRI_REG_COUNT];  /* SYSPRI1-SYSPRI3                  */
+    uint32 SysHndCtrl;                          /* SYSHNDCTRL exception enable bits */
+} NVIC_StateType;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES                                                         *
+ *******************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if NVIC_SHADOW_ENABLE
+
+/*********************************************************************
+ * Service Name: NVIC_EnableIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to enable Interrupt request for specific IRQ.
+ *              The store is skipped when the shadow shows the IRQ already enabled
+ **********************************************************************/
+void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num);
+
+/*********************************************************************
+ * Service Name: NVIC_DisableIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to disable Interrupt request for specific IRQ.
+ *              The store is skipped when the shadow shows the IRQ already disabled
+ **********************************************************************/
+void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num);
+
+#else
+
+/*********************************************************************
+ * Service Name: NVIC_EnableIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to enable Interrupt request for specific IRQ.
+ *              Inline and branch-free, a constant IRQ_Num folds to a single store
+ **********************************************************************/
+static inline void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num) {
+    NVIC_WRITE32(NVIC_EN_ADDR(NVIC_IRQ_WORD(IRQ_Num)), NVIC_IRQ_BIT(IRQ_Num));
+}
+
+/*********************************************************************
+ * Service Name: NVIC_DisableIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to disable Interrupt request for specific IRQ.
+ *              Inline and branch-free, a constant IRQ_Num folds to a single store
+ **********************************************************************/
+static inline void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num) {
+    NVIC_WRITE32(NVIC_DIS_ADDR(NVIC_IRQ_WORD(IRQ_Num)), NVIC_IRQ_BIT(IRQ_Num));
+}
+
+#endif /* NVIC_SHADOW_ENABLE */
+
+/*********************************************************************
+ * Service Name: NVIC_TriggerIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to pend an IRQ with a single store to SWTRIG. Callable
+ *              from unprivileged code once NVIC_AllowUnprivilegedTrigger(TRUE) ran
+ **********************************************************************/
+static inline void NVIC_TriggerIRQ(NVIC_IRQType IRQ_Num) {
+    NVIC_WRITE32(NVIC_SWTRIG_ADDR, (uint32)IRQ_Num & SWTRIG_INTID_MASK);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_EnableIRQMask
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Mask - Set of IRQs to enable
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to enable a set of IRQs with at most one store per ENn register
+ **********************************************************************/
+void NVIC_EnableIRQMask(const NVIC_IRQMaskType *IRQ_Mask);
+
+/*********************************************************************
+ * Service Name: NVIC_DisableIRQMask
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Mask - Set of IRQs to disable
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to disable a set of IRQs with at most one store per DISn register
+ **********************************************************************/
+void NVIC_DisableIRQMask(const NVIC_IRQMaskType *IRQ_Mask);
+
+/*********************************************************************
+ * Service Name: NVIC_MaskSet
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Mask - Set of IRQs to mask
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_MaskTokenType - IRQs of IRQ_Mask held masked by this scope
+ * Description: Function to open a critical section against a named set of IRQs only,
+ *              with one DISn store per affected word. No IRQ of the set runs once it
+ *              returns. Scopes nest and may close in any order: an IRQ is re-enabled
+ *              when the last scope covering it closes, and only if it was enabled
+ *              when the first one opened. Up to 255 scopes may cover one IRQ
+ **********************************************************************/
+NVIC_MaskTokenType NVIC_MaskSet(const NVIC_IRQMaskType *IRQ_Mask);
+
+/*********************************************************************
+ * Service Name: NVIC_UnmaskSet
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Token - Value returned by the matching NVIC_MaskSet
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to close a NVIC_MaskSet scope, re-enabling the IRQs no other
+ *              open scope still covers, with one ENn store per affected word
+ **********************************************************************/
+void NVIC_UnmaskSet(const NVIC_MaskTokenType *Token);
+
+/*********************************************************************
+ * Service Name: NVIC_EnableIRQList
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_List - Array of IRQs to enable
+ *                  IRQ_Count - Number of entries in IRQ_List
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to enable a list of IRQs with at most one store per ENn register
+ **********************************************************************/
+void NVIC_EnableIRQList(const NVIC_IRQType *IRQ_List, uint8 IRQ_Count);
+
+/*********************************************************************
+ * Service Name: NVIC_DisableIRQList
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_List - Array of IRQs to disable
+ *                  IRQ_Count - Number of entries in IRQ_List
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to disable a list of IRQs with at most one store per DISn register
+ **********************************************************************/
+void NVIC_DisableIRQList(const NVIC_IRQType *IRQ_List, uint8 IRQ_Count);
+
+/*********************************************************************
+ * Service Name: NVIC_SetPending
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Mask - Set of IRQs to pend
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to pend a set of IRQs with at most one store per PENDn register
+ **********************************************************************/
+void NVIC_SetPending(const NVIC_IRQMaskType *IRQ_Mask);
+
+/*********************************************************************
+ * Service Name: NVIC_ClearPending
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Mask - Set of IRQs to un-pend
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to un-pend a set of IRQs with at most one store per UNPENDn register
+ **********************************************************************/
+void NVIC_ClearPending(const NVIC_IRQMaskType *IRQ_Mask);
+
+/*********************************************************************
+ * Service Name: NVIC_IsPending
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the IRQ is pending
+ * Description: Function to check the PENDn bit of an IRQ
+ **********************************************************************/
+boolean NVIC_IsPending(NVIC_IRQType IRQ_Num);
+
+/*********************************************************************
+ * Service Name: NVIC_IsActive
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the IRQ handler is running or preempted
+ * Description: Function to check the ACTIVEn bit of an IRQ
+ **********************************************************************/
+boolean NVIC_IsActive(NVIC_IRQType IRQ_Num);
+
+/*********************************************************************
+ * Service Name: NVIC_AllowUnprivilegedTrigger
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Allow - TRUE to let unprivileged code write SWTRIG
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set or clear CFGCTRL.MAINPEND. Must run privileged
+ **********************************************************************/
+void NVIC_AllowUnprivilegedTrigger(boolean Allow);
+
+/*********************************************************************
+ * Service Name: NVIC_SetPriorityIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ *                  IRQ_Priority - Priority value for the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set the priority value for specific IRQ
+ **********************************************************************/
+void NVIC_SetPriorityIRQ(NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType IRQ_Priority);
+
+/*********************************************************************
+ * Service Name: NVIC_ApplyPriorityTable
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Priority_Table - Array of (IRQ, priority) pairs
+ *                  Table_Size - Number of entries in Priority_Table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to program the priorities of a table of IRQs with one
+ *              store per affected PRIn register and no read-back. IRQs sharing a
+ *              PRIn register with a table entry but missing from the table are
+ *              programmed to NVIC_PRIORITY_0 (the reset value). Entries with an
+ *              out-of-range or reserved IRQ are skipped
+ **********************************************************************/
+void NVIC_ApplyPriorityTable(const NVIC_IRQPriorityConfigType *Priority_Table, uint8 Table_Size);
+
+/*********************************************************************
+ * Service Name: NVIC_ApplyPriorityArray
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Priority_Array - Priority of every IRQ, indexed by IRQ number
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to program the priorities of all the IRQs with exactly
+ *              one store per PRIn register
+ **********************************************************************/
+void NVIC_ApplyPriorityArray(const NVIC_IRQPriorityType Priority_Array[NVIC_IRQ_COUNT]);
+
+/*********************************************************************
+ * Service Name: NVIC_EnableException
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Number of the exception from the system control block
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to enable specific ARM system or fault exceptions
+ **********************************************************************/
+void NVIC_EnableException(NVIC_ExceptionType Exception_Num);
+
+
+/*********************************************************************
+ * Service Name: NVIC_DisableException
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Number of the exception from the system control block
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to disable specific ARM system or fault exceptions
+ **********************************************************************/
+void NVIC_DisableException(NVIC_ExceptionType Exception_Num);
+
+/*********************************************************************
+ * Service Name: NVIC_SetPriorityException
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Number of the exception from the system control block
+ *                  Exception_Priority - Priority value for the exception
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set the priority value for specific ARM system or fault exceptions
+ **********************************************************************/
+void NVIC_SetPriorityException(NVIC_ExceptionType Exception_Num, NVIC_ExceptionPriorityType Exception_Priority);
+
+/*********************************************************************
+ * Service Name: NVIC_InitFromConfig
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to program the IRQ and exception configuration of
+ *              NVIC_Cfg.h. The register images are generated at build time,
+ *              so this only stores the priority grouping and precomputed PRIn,
+ *              SYSPRI1-3, SYSHNDCTRL and ENn words. Must be called from thread
+ *              mode during start-up
+ **********************************************************************/
+void NVIC_InitFromConfig(void);
+
+
+/*********************************************************************
+ * Service Name: NVIC_IsIRQEnabled
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the IRQ is enabled
+ * Description: Function to check whether an IRQ is enabled, answered from the
+ *              shadow when it is compiled in, from ENn otherwise
+ **********************************************************************/
+boolean NVIC_IsIRQEnabled(NVIC_IRQType IRQ_Num);
+
+/*********************************************************************
+ * Service Name: NVIC_GetPriorityIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_IRQPriorityType - Priority of the IRQ
+ * Description: Function to get the priority of an IRQ, answered from the
+ *              shadow when it is compiled in, from PRIn otherwise
+ **********************************************************************/
+NVIC_IRQPriorityType NVIC_GetPriorityIRQ(NVIC_IRQType IRQ_Num);
+
+/*********************************************************************
+ * Service Name: NVIC_IsExceptionEnabled
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Number of the exception from the system control block
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the exception is enabled
+ * Description: Function to check the SYSHNDCTRL enable bit of the fault and debug
+ *              monitor exceptions, the other exceptions have none and report TRUE
+ **********************************************************************/
+boolean NVIC_IsExceptionEnabled(NVIC_ExceptionType Exception_Num);
+
+/*********************************************************************
+ * Service Name: NVIC_GetPriorityException
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Number of the exception from the system control block
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_ExceptionPriorityType - Priority of the exception
+ * Description: Function to get the priority of a configurable exception. Reset,
+ *              NMI and Hard Fault have fixed negative priorities and report
+ *              NVIC_EXCEPTION_PRIORITY_0
+ **********************************************************************/
+NVIC_ExceptionPriorityType NVIC_GetPriorityException(NVIC_ExceptionType Exception_Num);
+
+/*********************************************************************
+ * Service Name: NVIC_BeginUpdate
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to start coalescing enable, priority and SYSHNDCTRL changes
+ *              in the shadow. Nothing reaches the registers until NVIC_CommitUpdate,
+ *              including changes made by ISRs in between. No effect without the shadow
+ **********************************************************************/
+void NVIC_BeginUpdate(void);
+
+/*********************************************************************
+ * Service Name: NVIC_CommitUpdate
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to write the net result of the changes made since
+ *              NVIC_BeginUpdate: one store per changed register, priorities
+ *              before enables. No effect without the shadow
+ **********************************************************************/
+void NVIC_CommitUpdate(void);
+
+/*********************************************************************
+ * Service Name: NVIC_SyncShadow
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to reload the shadow from the registers. The shadow starts
+ *              from the reset state, so this is only needed when something outside
+ *              the driver (e.g. a bootloader) programmed the NVIC. No effect without the shadow
+ **********************************************************************/
+void NVIC_SyncShadow(void);
+
+/*********************************************************************
+ * Service Name: NVIC_SaveState
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): State - Enable, priority and exception enable state
+ * Return value: None
+ * Description: Function to take a snapshot of the ENn, PRIn, SYSPRIn and SYSHNDCTRL
+ *              enable state, copied from the shadow when it is compiled in
+ **********************************************************************/
+void NVIC_SaveState(NVIC_StateType *State);
+
+/*********************************************************************
+ * Service Name: NVIC_RestoreState
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): State - Snapshot taken by NVIC_SaveState
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to program every register of a snapshot whatever the
+ *              current state, e.g. from retained RAM after the NVIC lost its
+ *              state. Priorities are restored before the enables. Inside an open
+ *              NVIC_BeginUpdate the snapshot is written at once and replaces the
+ *              changes coalesced so far; later ones wait for NVIC_CommitUpdate
+ **********************************************************************/
+void NVIC_RestoreState(const NVIC_StateType *State);
+
+/*********************************************************************
+ * Service Name: NVIC_RestoreStateChanged
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): State - Snapshot taken by NVIC_SaveState
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to bring the NVIC back to a snapshot storing only the
+ *              words that differ from the current state, and only the changed
+ *              bits of the ENn/DISn words. Priorities are restored before the enables
+ **********************************************************************/
+void NVIC_RestoreStateChanged(const NVIC_StateType *State);
+
+/*********************************************************************
+ * Service Name: NVIC_SetPriorityGrouping
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Priority_Group - Split of the priority bits into preemption/sub-priority
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to program APINT.PRIGROUP. Must be called before the
+ *              grouped priorities are assigned and before the IRQs are enabled
+ **********************************************************************/
+void NVIC_SetPriorityGrouping(NVIC_PriorityGroupType Priority_Group);
+
+/*********************************************************************
+ * Service Name: NVIC_GetPriorityGrouping
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_PriorityGroupType - Current priority grouping
+ * Description: Function to read APINT.PRIGROUP. The lower values, such as the
+ *              reset value, are returned as NVIC_PRIGROUP_ALL_PREEMPT, which they
+ *              behave as
+ **********************************************************************/
+NVIC_PriorityGroupType NVIC_GetPriorityGrouping(void);
+
+/*********************************************************************
+ * Service Name: NVIC_EncodePriority
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Priority_Group - Priority grouping the value is encoded for, an
+ *                                   out-of-range group is taken as NVIC_PRIGROUP_ALL_PREEMPT
+ *                  Preempt_Priority - Preemption priority, clamped to the group range
+ *                  Sub_Priority - Sub-priority, clamped to the group range
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_IRQPriorityType - Combined NVIC_PRIORITY_BITS priority value
+ * Description: Function to combine a (preempt, sub) pair into a priority value
+ **********************************************************************/
+static inline NVIC_IRQPriorityType NVIC_EncodePriority(NVIC_PriorityGroupType Priority_Group,
+                                                       uint8 Preempt_Priority, uint8 Sub_Priority) {
+    uint8 SubBits;
+    uint8 PreemptMax;
+    uint8 SubMax;
+    if ((Priority_Group < NVIC_PRIGROUP_ALL_PREEMPT) || (Priority_Group > NVIC_PRIGROUP_NO_PREEMPT)) {
+        Priority_Group = NVIC_PRIGROUP_ALL_PREEMPT;
+    }
+    SubBits = (uint8)((uint8)Priority_Group - (uint8)NVIC_PRIGROUP_ALL_PREEMPT);
+    PreemptMax = (uint8)((1U << (NVIC_PRIORITY_BITS - SubBits)) - 1U);
+    SubMax = (uint8)((1U << SubBits) - 1U);
+    if (Preempt_Priority > PreemptMax) {
+        Preempt_Priority = PreemptMax;
+    }
+    if (Sub_Priority > SubMax) {
+        Sub_Priority = SubMax;
+    }
+    return (NVIC_IRQPriorityType)(((uint32)Preempt_Priority << SubBits) | Sub_Priority);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_SetGroupedPriorityIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ *                  Preempt_Priority - Preemption priority of the IRQ
+ *                  Sub_Priority - Sub-priority of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set the priority of an IRQ as a (preempt, sub) pair
+ *              under the current priority grouping
+ **********************************************************************/
+void NVIC_SetGroupedPriorityIRQ(NVIC_IRQType IRQ_Num, uint8 Preempt_Priority, uint8 Sub_Priority);
+
+/*********************************************************************
+ * Service Name: NVIC_SetGroupedPriorityException
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Number of the exception from the system control block
+ *                  Preempt_Priority - Preemption priority of the exception
+ *                  Sub_Priority - Sub-priority of the exception
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set the priority of an exception as a (preempt, sub)
+ *              pair under the current priority grouping
+ **********************************************************************/
+void NVIC_SetGroupedPriorityException(NVIC_ExceptionType Exception_Num, uint8 Preempt_Priority, uint8 Sub_Priority);
+
+/*********************************************************************
+ * Service Name: NVIC_RelocateVectorTable
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Flash_Table - Vector table of the startup code (NVIC_VECTOR_COUNT entries)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to copy the vector table into the driver RAM table and
+ *              point VTABLE at it, after which handlers can be swapped at runtime
+ **********************************************************************/
+void NVIC_RelocateVectorTable(const NVIC_HandlerType *Flash_Table);
+
+/* RAM vector table, only valid after NVIC_RelocateVectorTable */
+extern volatile NVIC_HandlerType NVIC_RamVectorTable[NVIC_VECTOR_COUNT];
+
+/*********************************************************************
+ * Service Name: NVIC_SetHandler
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ *                  Handler - New handler of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to install an IRQ handler in the RAM vector table with a
+ *              single word store. The DSB makes the new vector visible before the
+ *              next exception entry
+ **********************************************************************/
+static inline void NVIC_SetHandler(NVIC_IRQType IRQ_Num, NVIC_HandlerType Handler) {
+    NVIC_RamVectorTable[NVIC_IRQ_VECTOR_OFFSET + (uint32)IRQ_Num] = Handler;
+    NVIC_DSB();
+}
+
+/*********************************************************************
+ * Service Name: NVIC_GetHandler
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_HandlerType - Handler currently installed for the IRQ
+ * Description: Function to read an IRQ handler from the RAM vector table
+ **********************************************************************/
+static inline NVIC_HandlerType NVIC_GetHandler(NVIC_IRQType IRQ_Num) {
+    return NVIC_RamVectorTable[NVIC_IRQ_VECTOR_OFFSET + (uint32)IRQ_Num];
+}
+
+/*********************************************************************
+ * Service Name: NVIC_SetExceptionHandler
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Number of the exception from the system control block
+ *                  Handler - New handler of the exception
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to install a system exception handler in the RAM vector
+ *              table. Reset is ignored, it is only fetched from the boot table
+ **********************************************************************/
+void NVIC_SetExceptionHandler(NVIC_ExceptionType Exception_Num, NVIC_HandlerType Handler);
+
+/*********************************************************************
+ * Service Name: NVIC_RaiseThreshold
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Threshold_Priority - Lowest priority level left running
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_ThresholdType - Previous threshold to hand to NVIC_RestoreThreshold
+ * Description: Function to open a critical section that masks only the IRQs and
+ *              exceptions with a priority value greater than or equal to
+ *              Threshold_Priority, higher priorities keep preempting. Uses
+ *              BASEPRI_MAX so a nested call never lowers an outer threshold.
+ *              NVIC_PRIORITY_0 cannot be masked this way, use Disable_Exceptions()
+ **********************************************************************/
+static inline NVIC_ThresholdType NVIC_RaiseThreshold(NVIC_IRQPriorityType Threshold_Priority) {
+    NVIC_ThresholdType Saved_Threshold = (NVIC_ThresholdType)NVIC_GET_BASEPRI();
+    NVIC_SET_BASEPRI_MAX((uint32)Threshold_Priority << NVIC_PRIORITY_BITS_POS);
+    return Saved_Threshold;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_RestoreThreshold
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Saved_Threshold - Value returned by the matching NVIC_RaiseThreshold
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to close a critical section opened by NVIC_RaiseThreshold
+ **********************************************************************/
+static inline void NVIC_RestoreThreshold(NVIC_ThresholdType Saved_Threshold) {
+    NVIC_SET_BASEPRI(Saved_Threshold);
+}
+
+#ifdef __cplusplus
+}
+
+/* Scoped BASEPRI critical section: raises the threshold on construction and
+ * restores the previous one when the scope is left */
+class NVIC_ThresholdGuard {
+public:
+    explicit NVIC_ThresholdGuard(NVIC_IRQPriorityType Threshold_Priority)
+        : Saved_Threshold(NVIC_RaiseThreshold(Threshold_Priority)) {}
+    ~NVIC_ThresholdGuard() { NVIC_RestoreThreshold(Saved_Threshold); }
+private:
+    NVIC_ThresholdGuard(const NVIC_ThresholdGuard &);
+    NVIC_ThresholdGuard &operator=(const NVIC_ThresholdGuard &);
+    NVIC_ThresholdType Saved_Threshold;
+};
+
+/* Build-time checked IRQ number behind NVIC_STATIC_IRQ, C++ cannot define a type inside sizeof */
+template <uint32 IRQ_Num>
+struct NVIC_StaticIRQ {
+    static_assert(NVIC_IRQ_IS_VALID(IRQ_Num), "IRQ number is reserved or out of range on the selected device");
+    static const NVIC_IRQType Value = (NVIC_IRQType)IRQ_Num;
+};
+#endif
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_H_ */
@@ -0,0 +1,210 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Cfg.h
+ *
+ * Description: Pre-compile configuration header file for the ARM Cortex M4 NVIC driver.
+ *              The tables below are expanded at build time into the EN/PRI/SYSPRI/
+ *              SYSHNDCTRL register images programmed by NVIC_InitFromConfig().
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_CFG_H_
+#define NVIC_CFG_H_
+
+/*******************************************************************************
+ * DEVICE                                                                      *
+ *******************************************************************************/
+
+/* Part the driver is specialized for, one of the NVIC_DEVICE_xxx of NVIC_Device.h */
+#ifndef NVIC_DEVICE
+#define NVIC_DEVICE                          NVIC_DEVICE_TM4C123GH6PM
+#endif
+
+/*******************************************************************************
+ * IRQ CONFIGURATION                                                           *
+ *******************************************************************************/
+
+/* Priority grouping programmed by NVIC_InitFromConfig, one of NVIC_PriorityGroupType */
+#define NVIC_CFG_PRIORITY_GROUPING           NVIC_PRIGROUP_ALL_PREEMPT
+
+/* X(IRQ_Num, IRQ_Priority, Enabled)
+ * IRQ_Num      - NVIC_IRQType of the interrupt, a reserved IRQ number fails the build
+ * IRQ_Priority - NVIC_IRQPriorityType, checked at build time
+ * Enabled      - TRUE to enable the IRQ in NVIC_InitFromConfig, FALSE to only set its priority */
+#define NVIC_CFG_IRQ_TABLE(X)                                       \
+    X(NVIC_IRQ_GPIO_PORTF,      NVIC_PRIORITY_5,    TRUE)           \
+    X(NVIC_IRQ_UART0,           NVIC_PRIORITY_3,    TRUE)           \
+    X(NVIC_IRQ_TIMER0A,         NVIC_PRIORITY_2,    TRUE)
+
+/*******************************************************************************
+ * EXCEPTION CONFIGURATION                                                     *
+ *******************************************************************************/
+
+/* X(Exception_Num, Exception_Priority, Enabled)
+ * Exception_Num      - NVIC_ExceptionType of the exception
+ * Exception_Priority - NVIC_ExceptionPriorityType, ignored for Reset, NMI and Hard Fault
+ * Enabled            - TRUE to set the exception enable bit in SYSHNDCTRL (fault and debug monitor exceptions) */
+#define NVIC_CFG_EXCEPTION_TABLE(X)                                             \
+    X(EXCEPTION_MEM_FAULT_TYPE,     NVIC_EXCEPTION_PRIORITY_0,  TRUE)           \
+    X(EXCEPTION_BUS_FAULT_TYPE,     NVIC_EXCEPTION_PRIORITY_0,  TRUE)           \
+    X(EXCEPTION_USAGE_FAULT_TYPE,   NVIC_EXCEPTION_PRIORITY_0,  TRUE)           \
+    X(EXCEPTION_SYSTICK_TYPE,       NVIC_EXCEPTION_PRIORITY_4,  TRUE)
+
+/*******************************************************************************
+ * INSTRUMENTATION                                                             *
+ *******************************************************************************/
+
+/* Per-IRQ entry count, occupancy and latency statistics (NVIC_Stats): 1 compiled in, 0 compiled out */
+#ifndef NVIC_STATS_ENABLE
+#define NVIC_STATS_ENABLE                    0
+#endif
+
+/*******************************************************************************
+ * STORM LIMITER                                                               *
+ *******************************************************************************/
+
+/* Per-IRQ interrupt storm limiter (NVIC_Storm): 1 compiled in, 0 compiled out */
+#ifndef NVIC_STORM_ENABLE
+#define NVIC_STORM_ENABLE                    0
+#endif
+
+/* Length of the counting window in NVIC_Storm_Tick() calls (SysTick periods) */
+#define NVIC_STORM_WINDOW_TICKS              10U
+
+/* X(IRQ_Num, Budget, Backoff_Ticks)
+ * IRQ_Num       - NVIC_IRQType of the rate-limited interrupt
+ * Budget        - Entries allowed per window, one more disables the IRQ
+ * Backoff_Ticks - NVIC_Storm_Tick() calls the IRQ stays disabled once throttled */
+#define NVIC_CFG_STORM_TABLE(X)                                     \
+    X(NVIC_IRQ_GPIO_PORTF,      20U,    100U)                       \
+    X(NVIC_IRQ_CAN0,            200U,   10U)
+
+/*******************************************************************************
+ * FAULT CAPTURE                                                               *
+ *******************************************************************************/
+
+/* Fault capture handlers and retained fault ring (NVIC_Fault): 1 compiled in, 0 compiled out */
+#ifndef NVIC_FAULT_ENABLE
+#define NVIC_FAULT_ENABLE                    0
+#endif
+
+/* Records kept in the fault ring, must be a power of two */
+#define NVIC_FAULT_RING_SIZE                 8U
+
+/* Linker section of the fault ring, must be left alone by the start-up code so
+ * the records survive a reset */
+#define NVIC_FAULT_RETAINED_SECTION          ".noinit"
+
+/* Action after a fault is recorded, NVIC_FAULT_ACTION_RESET or NVIC_FAULT_ACTION_RECOVER.
+ * A hook set with NVIC_Fault_SetHook overrides it. Without a hook moving the stacked PC,
+ * RECOVER only applies to imprecise bus faults, the others reset */
+#define NVIC_FAULT_HARD_FAULT_ACTION         NVIC_FAULT_ACTION_RESET
+#define NVIC_FAULT_MEM_FAULT_ACTION          NVIC_FAULT_ACTION_RESET
+#define NVIC_FAULT_BUS_FAULT_ACTION          NVIC_FAULT_ACTION_RESET
+#define NVIC_FAULT_USAGE_FAULT_ACTION        NVIC_FAULT_ACTION_RESET
+
+/*******************************************************************************
+ * SHADOW STATE                                                                *
+ *******************************************************************************/
+
+/* RAM shadow of the enable bits, IRQ priorities, SYSPRI1-3 and SYSHNDCTRL enables:
+ * 1 queries are answered from RAM and stores that change nothing are skipped,
+ * 0 every service goes straight to the registers */
+#ifndef NVIC_SHADOW_ENABLE
+#define NVIC_SHADOW_ENABLE                   0
+#endif
+
+/*******************************************************************************
+ * DEFERRED WORK                                                               *
+ *******************************************************************************/
+
+/* Capacity of the ISR-to-PendSV deferred work queue, must be a power of two */
+#define NVIC_DEFERRED_QUEUE_SIZE             32U
+
+/* Work items run per PendSV activation before PendSV re-pends itself */
+#define NVIC_DEFERRED_BATCH_SIZE             8U
+
+/*******************************************************************************
+ * FPU CONTEXT                                                                 *
+ *******************************************************************************/
+
+/* FPCCR stacking mode programmed by NVIC_Fpu_Init, one of NVIC_FpuStackingType */
+#ifndef NVIC_FPU_STACKING
+#define NVIC_FPU_STACKING                    NVIC_FPU_STACKING_LAZY
+#endif
+
+/* X(IRQ_Num)
+ * IRQ_Num - NVIC_IRQType whose handler never executes a floating-point instruction.
+ *           NVIC_FPU_STACKING_NONE is refused while an IRQ missing here is enabled */
+#define NVIC_CFG_FPU_FREE_TABLE(X)                                  \
+    X(NVIC_IRQ_GPIO_PORTF)                                          \
+    X(NVIC_IRQ_TIMER0A)
+
+/* Entry/exit cycle benchmark of the stacking modes (NVIC_Fpu_Benchmark): 1 compiled in, 0 compiled out */
+#ifndef NVIC_FPU_BENCH_ENABLE
+#define NVIC_FPU_BENCH_ENABLE                0
+#endif
+
+/* Spare IRQ the benchmark triggers, its handler and priority are restored afterwards */
+#define NVIC_FPU_BENCH_IRQ                   NVIC_IRQ_UDMA_SW
+
+/*******************************************************************************
+ * SLEEP                                                                       *
+ *******************************************************************************/
+
+/* SYSCTRL sleep controls programmed by NVIC_Sleep_Init:
+ * ON_EXIT       - TRUE to sleep again on every return to thread mode
+ * DEEP          - TRUE to use deep sleep (the system clock configuration decides what stops)
+ * EVENT_ON_PEND - TRUE to wake WFE on any IRQ becoming pending, enabled or not */
+#define NVIC_SLEEP_ON_EXIT                   FALSE
+#define NVIC_SLEEP_DEEP                      FALSE
+#define NVIC_SLEEP_EVENT_ON_PEND             FALSE
+
+/* Per-IRQ wake-up latency records (NVIC_Sleep): 1 compiled in, 0 compiled out */
+#ifndef NVIC_SLEEP_STATS_ENABLE
+#define NVIC_SLEEP_STATS_ENABLE              0
+#endif
+
+/*******************************************************************************
+ * TIMING BUDGETS                                                              *
+ *******************************************************************************/
+
+/* Inputs of the host analyzer (Tools/NVIC_Analyze.c), never compiled into the target.
+ * X(Source, Wcet_Cycles, Stack_Bytes, Deadline_Cycles, Interarrival_Cycles)
+ * Source              - NVIC_IRQType, or NVIC_ExceptionType in the exception table
+ * Wcet_Cycles         - Worst-case execution time of the handler body, the analyzer
+ *                       adds exception entry and exit
+ * Stack_Bytes         - Main stack used by the handler body, exception frame excluded
+ * Deadline_Cycles     - Longest allowed time from the request to the handler end, 0 for none
+ * Interarrival_Cycles - Shortest time between two requests, 0 for a source that is not
+ *                       recurring (faults): only its stack is accounted
+ * Every IRQ enabled in NVIC_CFG_IRQ_TABLE needs an entry. Exceptions take the priority
+ * of NVIC_CFG_EXCEPTION_TABLE, NMI and Hard Fault their fixed one */
+#define NVIC_CFG_IRQ_TIMING_TABLE(X)                                                \
+    X(NVIC_IRQ_GPIO_PORTF,      2000U,  128U,   400000U,    800000U)                \
+    X(NVIC_IRQ_UART0,           1200U,  96U,    20000U,     6944U)                  \
+    X(NVIC_IRQ_TIMER0A,         800U,   64U,    8000U,      80000U)
+
+#define NVIC_CFG_EXCEPTION_TIMING_TABLE(X)                                          \
+    X(EXCEPTION_HARD_FAULT_TYPE,    400U,   160U,   0U,     0U)                     \
+    X(EXCEPTION_MEM_FAULT_TYPE,     400U,   160U,   0U,     0U)                     \
+    X(EXCEPTION_BUS_FAULT_TYPE,     400U,   160U,   0U,     0U)                     \
+    X(EXCEPTION_USAGE_FAULT_TYPE,   400U,   160U,   0U,     0U)                     \
+    X(EXCEPTION_SYSTICK_TYPE,       600U,   64U,    80000U, 80000U)
+
+/* Main stack size, the part of it used by thread code when a handler preempts it
+ * (0 if the thread runs on the process stack), and the longest stretch the thread
+ * keeps all interrupts masked (PRIMASK critical sections) */
+#define NVIC_ANALYSIS_STACK_BYTES            2048U
+#define NVIC_ANALYSIS_THREAD_STACK_BYTES     512U
+#define NVIC_ANALYSIS_THREAD_BLOCKING_CYCLES 200U
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_CFG_H_ */
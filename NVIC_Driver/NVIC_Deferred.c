@@ -0,0 +1,234 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Deferred.c
+ *
+ * Description: Source file for the ISR-to-PendSV deferred work queue of the ARM Cortex M4
+ *              NVIC driver.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+
+#include "NVIC_Deferred.h"
+#include "NVIC_Regs.h"
+
+/* The position-to-slot mapping relies on the ring size being a power of two */
+typedef char NVIC_DeferredQueueSizeCheck[((NVIC_DEFERRED_QUEUE_SIZE != 0U) &&
+                                          ((NVIC_DEFERRED_QUEUE_SIZE & NVIC_DEFERRED_QUEUE_MASK) == 0U)) ? 1 : -1];
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+static NVIC_DeferredQueueType NVIC_DeferredQueue;
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+/*********************************************************************
+ * Service Name: NVIC_DeferredQueue_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): Queue - Ring to initialize
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to empty a deferred work ring
+ **********************************************************************/
+void NVIC_DeferredQueue_Init(NVIC_DeferredQueueType *Queue) {
+    uint32 Position;
+    if (Queue == NULL_PTR) {
+        return;
+    }
+    for (Position = 0; Position < NVIC_DEFERRED_QUEUE_SIZE; Position++) {
+        Queue->Slots[Position].Work = NULL_PTR;
+        Queue->Slots[Position].Context = NULL_PTR;
+        NVIC_ATOMIC_STORE(&Queue->Slots[Position].Sequence, Position);
+    }
+    Queue->Head = 0;
+    Queue->Dropped = 0;
+    NVIC_ATOMIC_STORE(&Queue->Tail, 0);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_DeferredQueue_Push
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Work - Function to run later
+ *                  Context - Argument passed to Work
+ * Parameters (inout): Queue - Ring to post into
+ * Parameters (out): None
+ * Return value: boolean - TRUE if queued, FALSE if the ring was full
+ * Description: Function to add a work item to the ring without locking, safe from
+ *              any number of concurrent producers (ISRs of any priority or threads)
+ **********************************************************************/
+boolean NVIC_DeferredQueue_Push(NVIC_DeferredQueueType *Queue, NVIC_DeferredWorkType Work, void *Context) {
+    uint32 Position;
+    uint32 Sequence;
+    uint32 Dropped;
+    NVIC_DeferredSlotType *Slot;
+
+    if ((Queue == NULL_PTR) || (Work == NULL_PTR)) {
+        return FALSE;
+    }
+    /* Reserve a position: the slot is free when its sequence equals the position,
+     * the tail is claimed with LDREX/STREX so concurrent producers get distinct slots */
+    for (;;) {
+        Position = NVIC_ATOMIC_LOAD(&Queue->Tail);
+        Slot = &Queue->Slots[Position & NVIC_DEFERRED_QUEUE_MASK];
+        Sequence = NVIC_ATOMIC_LOAD(&Slot->Sequence);
+        if (Sequence == Position) {
+            if (NVIC_ATOMIC_CAS(&Queue->Tail, Position, Position + 1U) == TRUE) {
+                break;
+            }
+        } else if ((sint32)(Sequence - Position) < 0) {
+            /* The slot still holds the item posted one lap ago: ring full */
+            do {
+                Dropped = NVIC_ATOMIC_LOAD(&Queue->Dropped);
+            } while (NVIC_ATOMIC_CAS(&Queue->Dropped, Dropped, Dropped + 1U) == FALSE);
+            return FALSE;
+        } else {
+            /* Another producer claimed this position first, retry with the new tail */
+        }
+    }
+    Slot->Work = Work;
+    Slot->Context = Context;
+    /* Publish: the consumer only reads Work/Context after seeing this sequence */
+    NVIC_ATOMIC_STORE(&Slot->Sequence, Position + 1U);
+    return TRUE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_DeferredQueue_Drain
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Max_Items - Maximum number of work items to run
+ * Parameters (inout): Queue - Ring to drain
+ * Parameters (out): None
+ * Return value: uint32 - Number of work items run
+ * Description: Function to run the published work items in posting order. Only
+ *              one consumer may drain a ring at a time
+ **********************************************************************/
+uint32 NVIC_DeferredQueue_Drain(NVIC_DeferredQueueType *Queue, uint32 Max_Items) {
+    uint32 Count = 0;
+    uint32 Position;
+    NVIC_DeferredSlotType *Slot;
+    NVIC_DeferredWorkType Work;
+    void *Context;
+
+    if (Queue == NULL_PTR) {
+        return 0;
+    }
+    Position = Queue->Head;
+    while (Count < Max_Items) {
+        Slot = &Queue->Slots[Position & NVIC_DEFERRED_QUEUE_MASK];
+        if (NVIC_ATOMIC_LOAD(&Slot->Sequence) != (Position + 1U)) {
+            /* Empty, or the next producer has reserved but not yet published */
+            break;
+        }
+        Work = Slot->Work;
+        Context = Slot->Context;
+        /* Hand the slot back to the producers of the next lap before running the work */
+        NVIC_ATOMIC_STORE(&Slot->Sequence, Position + NVIC_DEFERRED_QUEUE_SIZE);
+        Position++;
+        Queue->Head = Position;
+        Work(Context);
+        Count++;
+    }
+    return Count;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_DeferredQueue_IsEmpty
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Queue - Ring to check
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if no published work item is waiting
+ * Description: Function to check whether the consumer has anything to run
+ **********************************************************************/
+boolean NVIC_DeferredQueue_IsEmpty(NVIC_DeferredQueueType *Queue) {
+    uint32 Position;
+    if (Queue == NULL_PTR) {
+        return TRUE;
+    }
+    Position = Queue->Head;
+    return (NVIC_ATOMIC_LOAD(&Queue->Slots[Position & NVIC_DEFERRED_QUEUE_MASK].Sequence) != (Position + 1U)) ? TRUE : FALSE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Deferred_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to empty the system deferred work ring and give PendSV the
+ *              lowest priority. NVIC_Deferred_PendSVHandler must be the PendSV vector
+ *              (startup table or NVIC_SetExceptionHandler)
+ **********************************************************************/
+void NVIC_Deferred_Init(void) {
+    NVIC_DeferredQueue_Init(&NVIC_DeferredQueue);
+    NVIC_SetPriorityException(EXCEPTION_PEND_SV_TYPE, (NVIC_ExceptionPriorityType)NVIC_PRIORITY_MAX);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Deferred_Post
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Work - Function to run from PendSV
+ *                  Context - Argument passed to Work
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if queued, FALSE if the ring was full
+ * Description: Function to defer a work item to PendSV and pend PendSV
+ **********************************************************************/
+boolean NVIC_Deferred_Post(NVIC_DeferredWorkType Work, void *Context) {
+    if (NVIC_DeferredQueue_Push(&NVIC_DeferredQueue, Work, Context) == FALSE) {
+        return FALSE;
+    }
+    NVIC_WRITE32(NVIC_SYSTEM_INTCTRL_ADDR, INTCTRL_PENDSV_SET_MASK);
+    return TRUE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Deferred_PendSVHandler
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: PendSV handler running up to NVIC_DEFERRED_BATCH_SIZE work items,
+ *              it re-pends PendSV when more are waiting so pending interrupts are
+ *              served between batches
+ **********************************************************************/
+void NVIC_Deferred_PendSVHandler(void) {
+    (void)NVIC_DeferredQueue_Drain(&NVIC_DeferredQueue, NVIC_DEFERRED_BATCH_SIZE);
+    if (NVIC_DeferredQueue_IsEmpty(&NVIC_DeferredQueue) == FALSE) {
+        NVIC_WRITE32(NVIC_SYSTEM_INTCTRL_ADDR, INTCTRL_PENDSV_SET_MASK);
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Deferred_GetDropped
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Number of work items rejected because the ring was full
+ * Description: Function to get the overflow count of the system deferred work ring
+ **********************************************************************/
+uint32 NVIC_Deferred_GetDropped(void) {
+    return NVIC_ATOMIC_LOAD(&NVIC_DeferredQueue.Dropped);
+}
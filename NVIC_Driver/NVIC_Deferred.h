@@ -0,0 +1,174 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Deferred.h
+ *
+ * Description: Header file for the ISR-to-PendSV deferred work queue of the ARM Cortex M4
+ *              NVIC driver. Any ISR (or thread) posts a work item into a lock-free
+ *              multi-producer ring and pends PendSV, which runs at the lowest priority
+ *              and drains the ring in batches.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_DEFERRED_H_
+#define NVIC_DEFERRED_H_
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+#include "std_types.h"
+#include "NVIC.h"
+#include "NVIC_Cfg.h"
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+#define NVIC_DEFERRED_QUEUE_MASK             (NVIC_DEFERRED_QUEUE_SIZE - 1U)
+
+/*******************************************************************************
+ * DATA TYPES DDECLERATIONS                                                    *
+ *******************************************************************************/
+typedef void (*NVIC_DeferredWorkType)(void *Context);
+
+/* Slot of the ring. Sequence tells producers and the consumer who owns the slot:
+ * equal to the position when free, position + 1 once the work item is published */
+typedef struct
+{
+    volatile uint32 Sequence;
+    NVIC_DeferredWorkType Work;
+    void *Context;
+} NVIC_DeferredSlotType;
+
+/* Bounded multi-producer/single-consumer ring */
+typedef struct
+{
+    NVIC_DeferredSlotType Slots[NVIC_DEFERRED_QUEUE_SIZE];
+    volatile uint32 Tail;       /* Next position reserved by a producer */
+    volatile uint32 Head;       /* Next position run by the consumer    */
+    volatile uint32 Dropped;    /* Work items rejected because the ring was full */
+} NVIC_DeferredQueueType;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES                                                         *
+ *******************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************************************************************
+ * Service Name: NVIC_DeferredQueue_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): Queue - Ring to initialize
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to empty a deferred work ring
+ **********************************************************************/
+void NVIC_DeferredQueue_Init(NVIC_DeferredQueueType *Queue);
+
+/*********************************************************************
+ * Service Name: NVIC_DeferredQueue_Push
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Work - Function to run later
+ *                  Context - Argument passed to Work
+ * Parameters (inout): Queue - Ring to post into
+ * Parameters (out): None
+ * Return value: boolean - TRUE if queued, FALSE if the ring was full
+ * Description: Function to add a work item to the ring without locking, safe from
+ *              any number of concurrent producers (ISRs of any priority or threads)
+ **********************************************************************/
+boolean NVIC_DeferredQueue_Push(NVIC_DeferredQueueType *Queue, NVIC_DeferredWorkType Work, void *Context);
+
+/*********************************************************************
+ * Service Name: NVIC_DeferredQueue_Drain
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Max_Items - Maximum number of work items to run
+ * Parameters (inout): Queue - Ring to drain
+ * Parameters (out): None
+ * Return value: uint32 - Number of work items run
+ * Description: Function to run the published work items in posting order. Only
+ *              one consumer may drain a ring at a time
+ **********************************************************************/
+uint32 NVIC_DeferredQueue_Drain(NVIC_DeferredQueueType *Queue, uint32 Max_Items);
+
+/*********************************************************************
+ * Service Name: NVIC_DeferredQueue_IsEmpty
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Queue - Ring to check
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if no published work item is waiting
+ * Description: Function to check whether the consumer has anything to run
+ **********************************************************************/
+boolean NVIC_DeferredQueue_IsEmpty(NVIC_DeferredQueueType *Queue);
+
+/*********************************************************************
+ * Service Name: NVIC_Deferred_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to empty the system deferred work ring and give PendSV the
+ *              lowest priority. NVIC_Deferred_PendSVHandler must be the PendSV vector
+ *              (startup table or NVIC_SetExceptionHandler)
+ **********************************************************************/
+void NVIC_Deferred_Init(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Deferred_Post
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Work - Function to run from PendSV
+ *                  Context - Argument passed to Work
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if queued, FALSE if the ring was full
+ * Description: Function to defer a work item to PendSV and pend PendSV
+ **********************************************************************/
+boolean NVIC_Deferred_Post(NVIC_DeferredWorkType Work, void *Context);
+
+/*********************************************************************
+ * Service Name: NVIC_Deferred_PendSVHandler
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: PendSV handler running up to NVIC_DEFERRED_BATCH_SIZE work items,
+ *              it re-pends PendSV when more are waiting so pending interrupts are
+ *              served between batches
+ **********************************************************************/
+void NVIC_Deferred_PendSVHandler(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Deferred_GetDropped
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Number of work items rejected because the ring was full
+ * Description: Function to get the overflow count of the system deferred work ring
+ **********************************************************************/
+uint32 NVIC_Deferred_GetDropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_DEFERRED_H_ */
@@ -0,0 +1,96 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Device.h
+ *
+ * Description: Device descriptor selection for the ARM Cortex M4 NVIC driver. The part
+ *              picked by NVIC_DEVICE in NVIC_Cfg.h supplies the IRQ count, the implemented
+ *              priority bits, the valid-IRQ bitmap and its NVIC_IRQType, every loop bound,
+ *              shift and register-word count of the driver is derived from them.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_DEVICE_H_
+#define NVIC_DEVICE_H_
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+#include "std_types.h"
+#include "NVIC_Cfg.h"
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+/* Supported parts. A new part gets a NVIC_Device_<part>.h defining
+ * NVIC_DEVICE_IRQ_COUNT, NVIC_DEVICE_PRIORITY_BITS, NVIC_DEVICE_VALID_IRQ_WORDn
+ * (words past the IRQ count may be omitted) and NVIC_IRQType, plus a case below */
+#define NVIC_DEVICE_TM4C123GH6PM             1
+
+#if (NVIC_DEVICE == NVIC_DEVICE_TM4C123GH6PM)
+#include "NVIC_Device_TM4C123GH6PM.h"
+#else
+#error "NVIC_DEVICE does not name a supported part"
+#endif
+
+/* The Cortex-M4 NVIC implements at most 240 IRQs (8 ENn words) */
+#if (NVIC_DEVICE_IRQ_COUNT < 1U) || (NVIC_DEVICE_IRQ_COUNT > 240U)
+#error "NVIC_DEVICE_IRQ_COUNT must be 1 to 240"
+#endif
+
+/* NVIC_IRQPriorityType and NVIC_PriorityGroupType name the levels of 3 and 4 bit parts */
+#if (NVIC_DEVICE_PRIORITY_BITS != 3U) && (NVIC_DEVICE_PRIORITY_BITS != 4U)
+#error "NVIC_DEVICE_PRIORITY_BITS must be 3 or 4"
+#endif
+
+#ifndef NVIC_DEVICE_VALID_IRQ_WORD0
+#define NVIC_DEVICE_VALID_IRQ_WORD0          0UL
+#endif
+#ifndef NVIC_DEVICE_VALID_IRQ_WORD1
+#define NVIC_DEVICE_VALID_IRQ_WORD1          0UL
+#endif
+#ifndef NVIC_DEVICE_VALID_IRQ_WORD2
+#define NVIC_DEVICE_VALID_IRQ_WORD2          0UL
+#endif
+#ifndef NVIC_DEVICE_VALID_IRQ_WORD3
+#define NVIC_DEVICE_VALID_IRQ_WORD3          0UL
+#endif
+#ifndef NVIC_DEVICE_VALID_IRQ_WORD4
+#define NVIC_DEVICE_VALID_IRQ_WORD4          0UL
+#endif
+#ifndef NVIC_DEVICE_VALID_IRQ_WORD5
+#define NVIC_DEVICE_VALID_IRQ_WORD5          0UL
+#endif
+#ifndef NVIC_DEVICE_VALID_IRQ_WORD6
+#define NVIC_DEVICE_VALID_IRQ_WORD6          0UL
+#endif
+#ifndef NVIC_DEVICE_VALID_IRQ_WORD7
+#define NVIC_DEVICE_VALID_IRQ_WORD7          0UL
+#endif
+
+/* Valid-IRQ bitmap word n as a constant expression, usable in static checks */
+#define NVIC_DEVICE_VALID_IRQ_WORD(n)                                   \
+    (((uint32)(n) == 0U) ? NVIC_DEVICE_VALID_IRQ_WORD0 :                \
+     ((uint32)(n) == 1U) ? NVIC_DEVICE_VALID_IRQ_WORD1 :                \
+     ((uint32)(n) == 2U) ? NVIC_DEVICE_VALID_IRQ_WORD2 :                \
+     ((uint32)(n) == 3U) ? NVIC_DEVICE_VALID_IRQ_WORD3 :                \
+     ((uint32)(n) == 4U) ? NVIC_DEVICE_VALID_IRQ_WORD4 :                \
+     ((uint32)(n) == 5U) ? NVIC_DEVICE_VALID_IRQ_WORD5 :                \
+     ((uint32)(n) == 6U) ? NVIC_DEVICE_VALID_IRQ_WORD6 :                \
+     ((uint32)(n) == 7U) ? NVIC_DEVICE_VALID_IRQ_WORD7 : 0UL)
+
+/* Bits of ENn word n that lie below NVIC_DEVICE_IRQ_COUNT */
+#define NVIC_DEVICE_IMPLEMENTED_WORD(n)                                                 \
+    ((NVIC_DEVICE_IRQ_COUNT >= (((uint32)(n) + 1U) << 5)) ? 0xFFFFFFFFUL :              \
+     (NVIC_DEVICE_IRQ_COUNT <= ((uint32)(n) << 5)) ? 0UL :                              \
+     ((1UL << ((NVIC_DEVICE_IRQ_COUNT - ((uint32)(n) << 5)) & 31UL)) - 1UL))
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_DEVICE_H_ */
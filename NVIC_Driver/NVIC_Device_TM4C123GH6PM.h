@@ -0,0 +1,131 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Device_TM4C123GH6PM.h
+ *
+ * Description: Device descriptor of the TM4C123GH6PM for the ARM Cortex M4 NVIC driver:
+ *              implemented IRQs, implemented priority bits and the IRQ numbers.
+ *              Selected with NVIC_DEVICE set to NVIC_DEVICE_TM4C123GH6PM in NVIC_Cfg.h.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_DEVICE_TM4C123GH6PM_H_
+#define NVIC_DEVICE_TM4C123GH6PM_H_
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+/* Highest implemented IRQ number + 1 */
+#define NVIC_DEVICE_IRQ_COUNT                139U
+
+/* Implemented bits of each 8-bit priority field (bits 7:5) */
+#define NVIC_DEVICE_PRIORITY_BITS            3U
+
+/* IRQs with a peripheral behind them, one bit per IRQ laid out like EN0-EN4.
+ * Reserved: 27, 31-32, 41-42, 52-56, 64-67, 72-91, 107-133 */
+#define NVIC_DEVICE_VALID_IRQ_WORD0          0x77FFFFFFUL
+#define NVIC_DEVICE_VALID_IRQ_WORD1          0xFE0FF9FEUL
+#define NVIC_DEVICE_VALID_IRQ_WORD2          0xF00000F0UL
+#define NVIC_DEVICE_VALID_IRQ_WORD3          0x000007FFUL
+#define NVIC_DEVICE_VALID_IRQ_WORD4          0x000007C0UL
+
+/*******************************************************************************
+ * DATA TYPES DDECLERATIONS                                                    *
+ *******************************************************************************/
+typedef enum {
+    NVIC_IRQ_GPIO_PORTA = 0,         // Interrupt 16: GPIO Port A
+    NVIC_IRQ_GPIO_PORTB = 1,         // Interrupt 17: GPIO Port B
+    NVIC_IRQ_GPIO_PORTC = 2,         // Interrupt 18: GPIO Port C
+    NVIC_IRQ_GPIO_PORTD = 3,         // Interrupt 19: GPIO Port D
+    NVIC_IRQ_GPIO_PORTE = 4,         // Interrupt 20: GPIO Port E
+    NVIC_IRQ_UART0 = 5,              // Interrupt 21: UART0
+    NVIC_IRQ_UART1 = 6,              // Interrupt 22: UART1
+    NVIC_IRQ_SSI0 = 7,               // Interrupt 23: SSI0
+    NVIC_IRQ_I2C0 = 8,               // Interrupt 24: I2C0
+    NVIC_IRQ_PWM0_FAULT = 9,         // Interrupt 25: PWM0 Fault
+    NVIC_IRQ_PWM0_GEN0 = 10,         // Interrupt 26: PWM0 Generator 0
+    NVIC_IRQ_PWM0_GEN1 = 11,         // Interrupt 27: PWM0 Generator 1
+    NVIC_IRQ_PWM0_GEN2 = 12,         // Interrupt 28: PWM0 Generator 2
+    NVIC_IRQ_QEI0 = 13,              // Interrupt 29: QEI0
+    NVIC_IRQ_ADC0_SEQ0 = 14,         // Interrupt 30: ADC0 Sequence 0
+    NVIC_IRQ_ADC0_SEQ1 = 15,         // Interrupt 31: ADC0 Sequence 1
+    NVIC_IRQ_ADC0_SEQ2 = 16,         // Interrupt 32: ADC0 Sequence 2
+    NVIC_IRQ_ADC0_SEQ3 = 17,         // Interrupt 33: ADC0 Sequence 3
+    NVIC_IRQ_WATCHDOG = 18,          // Interrupt 34: Watchdog Timers 0 and 1
+    NVIC_IRQ_TIMER0A = 19,           // Interrupt 35: 16/32-Bit Timer 0A
+    NVIC_IRQ_TIMER0B = 20,           // Interrupt 36: 16/32-Bit Timer 0B
+    NVIC_IRQ_TIMER1A = 21,           // Interrupt 37: 16/32-Bit Timer 1A
+    NVIC_IRQ_TIMER1B = 22,           // Interrupt 38: 16/32-Bit Timer 1B
+    NVIC_IRQ_TIMER2A = 23,           // Interrupt 39: 16/32-Bit Timer 2A
+    NVIC_IRQ_TIMER2B = 24,           // Interrupt 40: 16/32-Bit Timer 2B
+    NVIC_IRQ_COMP0 = 25,             // Interrupt 41: Analog Comparator 0
+    NVIC_IRQ_COMP1 = 26,             // Interrupt 42: Analog Comparator 1
+    // Reserved 27
+    NVIC_IRQ_SYSCTL = 28,            // Interrupt 44: System Control
+    NVIC_IRQ_FLASH = 29,             // Interrupt 45: Flash Memory Control and EEPROM Control
+    NVIC_IRQ_GPIO_PORTF = 30,        // Interrupt 46: GPIO Port F
+    // Reserved 31-32
+    NVIC_IRQ_UART2 = 33,             // Interrupt 49: UART2
+    NVIC_IRQ_SSI1 = 34,              // Interrupt 50: SSI1
+    NVIC_IRQ_TIMER3A = 35,           // Interrupt 51: 16/32-Bit Timer 3A
+    NVIC_IRQ_TIMER3B = 36,           // Interrupt 52: 16/32-Bit Timer 3B
+    NVIC_IRQ_I2C1 = 37,              // Interrupt 53: I2C1
+    NVIC_IRQ_QEI1 = 38,              // Interrupt 54: QEI1
+    NVIC_IRQ_CAN0 = 39,              // Interrupt 55: CAN0
+    NVIC_IRQ_CAN1 = 40,              // Interrupt 56: CAN1
+    // Reserved 41-42
+    NVIC_IRQ_HIBERNATION = 43,       // Interrupt 59: Hibernation Module
+    NVIC_IRQ_USB = 44,               // Interrupt 60: USB
+    NVIC_IRQ_PWM_GEN3 = 45,          // Interrupt 61: PWM Generator 3
+    NVIC_IRQ_UDMA_SW = 46,           // Interrupt 62: uDMA Software
+    NVIC_IRQ_UDMA_ERR = 47,          // Interrupt 63: uDMA Error
+    NVIC_IRQ_ADC1_SEQ0 = 48,         // Interrupt 64: ADC1 Sequence 0
+    NVIC_IRQ_ADC1_SEQ1 = 49,         // Interrupt 65: ADC1 Sequence 1
+    NVIC_IRQ_ADC1_SEQ2 = 50,         // Interrupt 66: ADC1 Sequence 2
+    NVIC_IRQ_ADC1_SEQ3 = 51,         // Interrupt 67: ADC1 Sequence 3
+    // Reserved 52-56
+    NVIC_IRQ_SSI2 = 57,              // Interrupt 73: SSI2
+    NVIC_IRQ_SSI3 = 58,              // Interrupt 74: SSI3
+    NVIC_IRQ_UART3 = 59,             // Interrupt 75: UART3
+    NVIC_IRQ_UART4 = 60,             // Interrupt 76: UART4
+    NVIC_IRQ_UART5 = 61,             // Interrupt 77: UART5
+    NVIC_IRQ_UART6 = 62,             // Interrupt 78: UART6
+    NVIC_IRQ_UART7 = 63,             // Interrupt 79: UART7
+    // Reserved 64-67
+    NVIC_IRQ_I2C2 = 68,              // Interrupt 84: I2C2
+    NVIC_IRQ_I2C3 = 69,              // Interrupt 85: I2C3
+    NVIC_IRQ_TIMER4A = 70,           // Interrupt 86: 16/32-Bit Timer 4A
+    NVIC_IRQ_TIMER4B = 71,           // Interrupt 87: 16/32-Bit Timer 4B
+    // Reserved 72-91
+    NVIC_IRQ_TIMER5A = 92,           // Interrupt 108: 16/32-Bit Timer 5A
+    NVIC_IRQ_TIMER5B = 93,           // Interrupt 109: 16/32-Bit Timer 5B
+    NVIC_IRQ_TIMER0A_64 = 94,        // Interrupt 110: 32/64-Bit Timer 0A
+    NVIC_IRQ_TIMER0B_64 = 95,        // Interrupt 111: 32/64-Bit Timer 0B
+    NVIC_IRQ_TIMER1A_64 = 96,        // Interrupt 112: 32/64-Bit Timer 1A
+    NVIC_IRQ_TIMER1B_64 = 97,        // Interrupt 113: 32/64-Bit Timer 1B
+    NVIC_IRQ_TIMER2A_64 = 98,        // Interrupt 114: 32/64-Bit Timer 2A
+    NVIC_IRQ_TIMER2B_64 = 99,        // Interrupt 115: 32/64-Bit Timer 2B
+    NVIC_IRQ_TIMER3A_64 = 100,       // Interrupt 116: 32/64-Bit Timer 3A
+    NVIC_IRQ_TIMER3B_64 = 101,       // Interrupt 117: 32/64-Bit Timer 3B
+    NVIC_IRQ_TIMER4A_64 = 102,       // Interrupt 118: 32/64-Bit Timer 4A
+    NVIC_IRQ_TIMER4B_64 = 103,       // Interrupt 119: 32/64-Bit Timer 4B
+    NVIC_IRQ_TIMER5A_64 = 104,       // Interrupt 120: 32/64-Bit Timer 5A
+    NVIC_IRQ_TIMER5B_64 = 105,       // Interrupt 121: 32/64-Bit Timer 5B
+    NVIC_IRQ_SYSTEM_EXCEPTION = 106, // Interrupt 122: System Exception (imprecise)
+    // Reserved 107-133
+    NVIC_IRQ_PWM1_GEN0 = 134,        // Interrupt 150: PWM1 Generator 0
+    NVIC_IRQ_PWM1_GEN1 = 135,        // Interrupt 151: PWM1 Generator 1
+    NVIC_IRQ_PWM1_GEN2 = 136,        // Interrupt 152: PWM1 Generator 2
+    NVIC_IRQ_PWM1_GEN3 = 137,        // Interrupt 153: PWM1 Generator 3
+    NVIC_IRQ_PWM1_FAULT = 138,       // Interrupt 154: PWM1 Fault
+} NVIC_IRQType;
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_DEVICE_TM4C123GH6PM_H_ */
@@ -0,0 +1,313 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Fault.c
+ *
+ * Description: Source file for the fault capture of the ARM Cortex M4 NVIC driver.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+
+#include "NVIC_Fault.h"
+#include "NVIC_Regs.h"
+
+#if NVIC_FAULT_ENABLE
+
+/* The handlers pass the fault kind as an immediate, these must match NVIC_ExceptionType */
+#define NVIC_FAULT_KIND_HARD                 2
+#define NVIC_FAULT_KIND_MEM                  3
+#define NVIC_FAULT_KIND_BUS                  4
+#define NVIC_FAULT_KIND_USAGE                5
+
+typedef char NVIC_FaultKindCheck[((NVIC_FAULT_KIND_HARD == EXCEPTION_HARD_FAULT_TYPE) &&
+                                  (NVIC_FAULT_KIND_MEM == EXCEPTION_MEM_FAULT_TYPE) &&
+                                  (NVIC_FAULT_KIND_BUS == EXCEPTION_BUS_FAULT_TYPE) &&
+                                  (NVIC_FAULT_KIND_USAGE == EXCEPTION_USAGE_FAULT_TYPE)) ? 1 : -1];
+
+/* The record slot is picked with a mask */
+typedef char NVIC_FaultRingSizeCheck[((NVIC_FAULT_RING_SIZE != 0U) &&
+                                      ((NVIC_FAULT_RING_SIZE & (NVIC_FAULT_RING_SIZE - 1U)) == 0U)) ? 1 : -1];
+
+/* Marks a formatted ring, anything else in retained RAM is power-on garbage */
+#define NVIC_FAULT_RING_MAGIC                0x4E564643UL
+
+/*******************************************************************************
+ * DATA TYPES DDECLERATIONS                                                    *
+ *******************************************************************************/
+
+typedef struct
+{
+    uint32 Magic;
+    uint32 Count;                                           /* Records written since formatting */
+    NVIC_FaultRecordType Records[NVIC_FAULT_RING_SIZE];
+} NVIC_FaultRingType;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+static volatile NVIC_FaultRingType NVIC_FaultRing __attribute__((section(NVIC_FAULT_RETAINED_SECTION)));
+static NVIC_FaultHookType NVIC_FaultHook = NULL_PTR;
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+#ifndef NVIC_HOST_SIM
+
+#define NVIC_FAULT_STRINGIFY(Value)          #Value
+#define NVIC_FAULT_STRING(Value)             NVIC_FAULT_STRINGIFY(Value)
+
+/* Only basic asm may appear in a naked function: EXC_RETURN bit 2 tells which
+ * stack holds the frame, the capture is reached with a tail branch so its
+ * return performs the exception return */
+#define NVIC_FAULT_HANDLER(Handler_Name, Kind)                  \
+    __attribute__((naked)) void Handler_Name(void) {            \
+        __asm volatile (                                        \
+            "TST LR, #4                 \n"                     \
+            "ITE EQ                     \n"                     \
+            "MRSEQ R0, MSP              \n"                     \
+            "MRSNE R0, PSP              \n"                     \
+            "MOV R1, LR                 \n"                     \
+            "MOV R2, #" NVIC_FAULT_STRING(Kind) "\n"            \
+            "B NVIC_Fault_Capture       \n");                   \
+    }
+
+NVIC_FAULT_HANDLER(NVIC_Fault_HardFaultHandler, NVIC_FAULT_KIND_HARD)
+NVIC_FAULT_HANDLER(NVIC_Fault_MemFaultHandler, NVIC_FAULT_KIND_MEM)
+NVIC_FAULT_HANDLER(NVIC_Fault_BusFaultHandler, NVIC_FAULT_KIND_BUS)
+NVIC_FAULT_HANDLER(NVIC_Fault_UsageFaultHandler, NVIC_FAULT_KIND_USAGE)
+
+#endif /* NVIC_HOST_SIM */
+
+/* Configured action of a fault kind */
+static NVIC_FaultActionType NVIC_Fault_ConfiguredAction(uint32 Kind) {
+    switch (Kind) {
+        case NVIC_FAULT_KIND_MEM:
+            return NVIC_FAULT_MEM_FAULT_ACTION;
+        case NVIC_FAULT_KIND_BUS:
+            return NVIC_FAULT_BUS_FAULT_ACTION;
+        case NVIC_FAULT_KIND_USAGE:
+            return NVIC_FAULT_USAGE_FAULT_ACTION;
+        default:
+            return NVIC_FAULT_HARD_FAULT_ACTION;
+    }
+}
+
+/* Returning is only safe when it does not re-execute the faulting instruction: the
+ * hook moved the stacked PC, or the fault is an imprecise bus fault alone (also when
+ * escalated), whose stacked PC is already past the store that caused it. A fault on
+ * stacking never returns */
+static boolean NVIC_Fault_CanResume(const NVIC_FaultRecordType *Record, const uint32 *Frame) {
+    /* There is no frame to unstack */
+    if ((Record->FaultStat & NVIC_FAULT_STACKING_MASK) != 0) {
+        return FALSE;
+    }
+    if (Frame[NVIC_FAULT_FRAME_PC] != Record->Frame[NVIC_FAULT_FRAME_PC]) {
+        return TRUE;
+    }
+    return (Record->FaultStat == FAULTSTAT_IMPRE_MASK) ? TRUE : FALSE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Fault_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to format the fault ring unless it already holds valid
+ *              records from before the last reset. The handlers below must be the
+ *              fault vectors (startup table or NVIC_SetExceptionHandler)
+ **********************************************************************/
+void NVIC_Fault_Init(void) {
+    if (NVIC_FaultRing.Magic != NVIC_FAULT_RING_MAGIC) {
+        NVIC_Fault_Clear();
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Fault_Clear
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to discard every record of the fault ring
+ **********************************************************************/
+void NVIC_Fault_Clear(void) {
+    uint32 Slot;
+    for (Slot = 0; Slot < NVIC_FAULT_RING_SIZE; Slot++) {
+        NVIC_FaultRing.Records[Slot].Sequence = 0;
+    }
+    NVIC_FaultRing.Count = 0;
+    NVIC_COMPILER_BARRIER();
+    NVIC_FaultRing.Magic = NVIC_FAULT_RING_MAGIC;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Fault_GetCount
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Faults recorded since the ring was formatted
+ * Description: Function to get the number of faults recorded, only the last
+ *              NVIC_FAULT_RING_SIZE of them are kept
+ **********************************************************************/
+uint32 NVIC_Fault_GetCount(void) {
+    return (NVIC_FaultRing.Magic == NVIC_FAULT_RING_MAGIC) ? NVIC_FaultRing.Count : 0;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Fault_GetRecord
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Age - 0 for the latest fault, 1 for the one before, ...
+ * Parameters (inout): None
+ * Parameters (out): Record - Copy of the fault record
+ * Return value: boolean - TRUE if the record exists
+ * Description: Function to read a record of the fault ring
+ **********************************************************************/
+boolean NVIC_Fault_GetRecord(uint32 Age, NVIC_FaultRecordType *Record) {
+    uint32 Count = NVIC_Fault_GetCount();
+    uint32 Slot;
+    uint32 Index;
+
+    if ((Record == NULL_PTR) || (Age >= Count) || (Age >= NVIC_FAULT_RING_SIZE)) {
+        return FALSE;
+    }
+    Slot = (Count - 1U - Age) & (NVIC_FAULT_RING_SIZE - 1U);
+    /* A reset in the middle of a capture leaves the slot without its sequence */
+    if (NVIC_FaultRing.Records[Slot].Sequence != (Count - Age)) {
+        return FALSE;
+    }
+    Record->Sequence = NVIC_FaultRing.Records[Slot].Sequence;
+    Record->Kind = NVIC_FaultRing.Records[Slot].Kind;
+    for (Index = 0; Index < NVIC_FAULT_FRAME_WORDS; Index++) {
+        Record->Frame[Index] = NVIC_FaultRing.Records[Slot].Frame[Index];
+    }
+    Record->ExcReturn = NVIC_FaultRing.Records[Slot].ExcReturn;
+    Record->FaultStat = NVIC_FaultRing.Records[Slot].FaultStat;
+    Record->HFaultStat = NVIC_FaultRing.Records[Slot].HFaultStat;
+    Record->MmAddr = NVIC_FaultRing.Records[Slot].MmAddr;
+    Record->FaultAddr = NVIC_FaultRing.Records[Slot].FaultAddr;
+    return TRUE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Fault_SetHook
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Hook - Function deciding the action after a capture, NULL_PTR
+ *                         to use the NVIC_FAULT_xxx_ACTION configuration
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to install the fault policy hook, it runs in the fault handler
+ **********************************************************************/
+void NVIC_Fault_SetHook(NVIC_FaultHookType Hook) {
+    NVIC_FaultHook = Hook;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Fault_Capture
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Exc_Return - EXC_RETURN value of the fault handler
+ *                  Kind - NVIC_ExceptionType of the fault
+ * Parameters (inout): Frame - Stacked exception frame of the faulting context
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function the naked handlers branch to: records the fault in a fixed
+ *              number of loads and stores, then resets or returns as decided by
+ *              the hook or the configuration. A recover that would return to the
+ *              faulting instruction, or from a fault on stacking, resets instead
+ **********************************************************************/
+void NVIC_Fault_Capture(uint32 *Frame, uint32 Exc_Return, uint32 Kind) {
+    volatile NVIC_FaultRecordType *Slot;
+    NVIC_FaultRecordType Record;
+    uint32 NoFrame[NVIC_FAULT_FRAME_WORDS];
+    NVIC_FaultActionType Action;
+    uint32 Count;
+    uint32 Index;
+
+    /* A ring never formatted (fault before NVIC_Fault_Init) is formatted here */
+    if (NVIC_FaultRing.Magic != NVIC_FAULT_RING_MAGIC) {
+        NVIC_Fault_Clear();
+    }
+    Count = NVIC_FaultRing.Count;
+
+    Record.Kind = Kind;
+    Record.ExcReturn = Exc_Return;
+    Record.FaultStat = NVIC_READ32(NVIC_SYSTEM_FAULTSTAT_ADDR);
+    /* A fault on stacking leaves Frame pointing at words that were never written,
+     * possibly past the end of an overflowed stack: it is not read, and the hook
+     * gets the zeroed copy */
+    if ((Record.FaultStat & NVIC_FAULT_STACKING_MASK) != 0) {
+        for (Index = 0; Index < NVIC_FAULT_FRAME_WORDS; Index++) {
+            Record.Frame[Index] = 0;
+            NoFrame[Index] = 0;
+        }
+        Frame = NoFrame;
+    } else {
+        for (Index = 0; Index < NVIC_FAULT_FRAME_WORDS; Index++) {
+            Record.Frame[Index] = Frame[Index];
+        }
+    }
+    Record.HFaultStat = NVIC_READ32(NVIC_SYSTEM_HFAULTSTAT_ADDR);
+    Record.MmAddr = NVIC_READ32(NVIC_SYSTEM_MMADDR_ADDR);
+    Record.FaultAddr = NVIC_READ32(NVIC_SYSTEM_FAULTADDR_ADDR);
+    Record.Sequence = Count + 1U;
+
+    /* The sequence is stored last so a reset halfway leaves the slot invalid */
+    Slot = &NVIC_FaultRing.Records[Count & (NVIC_FAULT_RING_SIZE - 1U)];
+    Slot->Sequence = 0;
+    NVIC_COMPILER_BARRIER();
+    Slot->Kind = Record.Kind;
+    for (Index = 0; Index < NVIC_FAULT_FRAME_WORDS; Index++) {
+        Slot->Frame[Index] = Record.Frame[Index];
+    }
+    Slot->ExcReturn = Record.ExcReturn;
+    Slot->FaultStat = Record.FaultStat;
+    Slot->HFaultStat = Record.HFaultStat;
+    Slot->MmAddr = Record.MmAddr;
+    Slot->FaultAddr = Record.FaultAddr;
+    NVIC_COMPILER_BARRIER();
+    Slot->Sequence = Record.Sequence;
+    NVIC_FaultRing.Count = Count + 1U;
+    NVIC_DSB();
+
+    if (NVIC_FaultHook != NULL_PTR) {
+        Action = NVIC_FaultHook(&Record, Frame);
+    } else {
+        Action = NVIC_Fault_ConfiguredAction(Kind);
+    }
+
+    if ((Action == NVIC_FAULT_ACTION_RECOVER) && (NVIC_Fault_CanResume(&Record, Frame) == TRUE)) {
+        /* Status bits are write-one-to-clear, only the captured ones are cleared */
+        NVIC_WRITE32(NVIC_SYSTEM_FAULTSTAT_ADDR, Record.FaultStat);
+        NVIC_WRITE32(NVIC_SYSTEM_HFAULTSTAT_ADDR, Record.HFaultStat);
+        NVIC_DSB();
+        return;
+    }
+
+    NVIC_WRITE32(NVIC_SYSTEM_APINT_ADDR, APINT_VECTKEY | APINT_SYSRESETREQ_MASK);
+    NVIC_DSB();
+#ifndef NVIC_HOST_SIM
+    /* The reset is not instantaneous */
+    for (;;) {
+    }
+#endif
+}
+
+#endif /* NVIC_FAULT_ENABLE */
@@ -0,0 +1,233 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Fault.h
+ *
+ * Description: Header file for the fault capture of the ARM Cortex M4 NVIC driver.
+ *              Naked Hard Fault, MemManage, Bus Fault and Usage Fault handlers copy
+ *              the stacked frame and the fault status/address registers into a ring
+ *              kept in retained RAM, then reset or return as configured. The record
+ *              decoder has no register access so it also builds on the host.
+ *              Capture is compiled in with NVIC_FAULT_ENABLE set to 1 in NVIC_Cfg.h.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_FAULT_H_
+#define NVIC_FAULT_H_
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+#include "std_types.h"
+#include "NVIC.h"
+#include "NVIC_Cfg.h"
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+/* Words of the basic exception frame and their order on the stack */
+#define NVIC_FAULT_FRAME_WORDS               8U
+#define NVIC_FAULT_FRAME_R0                  0U
+#define NVIC_FAULT_FRAME_R1                  1U
+#define NVIC_FAULT_FRAME_R2                  2U
+#define NVIC_FAULT_FRAME_R3                  3U
+#define NVIC_FAULT_FRAME_R12                 4U
+#define NVIC_FAULT_FRAME_LR                  5U
+#define NVIC_FAULT_FRAME_PC                  6U
+#define NVIC_FAULT_FRAME_XPSR                7U
+
+/* FAULTSTAT (CFSR) bits: MemManage (7:0), Bus Fault (15:8), Usage Fault (31:16) */
+#define FAULTSTAT_IERR_MASK                  0x00000001
+#define FAULTSTAT_DERR_MASK                  0x00000002
+#define FAULTSTAT_MUSTKE_MASK                0x00000008
+#define FAULTSTAT_MSTKE_MASK                 0x00000010
+#define FAULTSTAT_MLSPERR_MASK               0x00000020
+#define FAULTSTAT_MMARV_MASK                 0x00000080
+#define FAULTSTAT_IBUS_MASK                  0x00000100
+#define FAULTSTAT_PRECISE_MASK               0x00000200
+#define FAULTSTAT_IMPRE_MASK                 0x00000400
+#define FAULTSTAT_BUSTKE_MASK                0x00000800
+#define FAULTSTAT_BSTKE_MASK                 0x00001000
+#define FAULTSTAT_BLSPERR_MASK               0x00002000
+#define FAULTSTAT_BFARV_MASK                 0x00008000
+#define FAULTSTAT_UNDEF_MASK                 0x00010000
+#define FAULTSTAT_INVSTAT_MASK               0x00020000
+#define FAULTSTAT_INVPC_MASK                 0x00040000
+#define FAULTSTAT_NOCP_MASK                  0x00080000
+#define FAULTSTAT_UNALIGN_MASK               0x01000000
+#define FAULTSTAT_DIV0_MASK                  0x02000000
+
+/* Faults on exception entry stacking: the stacked frame was never (fully) written */
+#define NVIC_FAULT_STACKING_MASK             (FAULTSTAT_MSTKE_MASK | FAULTSTAT_BSTKE_MASK)
+
+/* HFAULTSTAT (HFSR) bits */
+#define HFAULTSTAT_VECT_MASK                 0x00000002
+#define HFAULTSTAT_FORCED_MASK               0x40000000
+#define HFAULTSTAT_DBG_MASK                  0x80000000
+
+/* APINT system reset request */
+#define APINT_SYSRESETREQ_MASK               0x00000004
+
+/*******************************************************************************
+ * DATA TYPES DDECLERATIONS                                                    *
+ *******************************************************************************/
+
+/* What the handler does once the fault is recorded */
+typedef enum {
+    NVIC_FAULT_ACTION_RESET = 0,    /* Request a system reset through APINT                     */
+    NVIC_FAULT_ACTION_RECOVER = 1,  /* Clear the fault status and return to the stacked PC.
+                                     * The stacked PC of a precise fault is the faulting
+                                     * instruction, so this only applies when the hook has
+                                     * changed Frame[NVIC_FAULT_FRAME_PC] or the fault is an
+                                     * imprecise bus fault; any other fault, and any fault
+                                     * on stacking, resets                                   */
+} NVIC_FaultActionType;
+
+/* One captured fault, plain words so a RAM dump decodes on any host */
+typedef struct {
+    uint32 Sequence;                            /* Fault number since the ring was formatted, from 1 */
+    uint32 Kind;                                /* NVIC_ExceptionType of the fault                   */
+    uint32 Frame[NVIC_FAULT_FRAME_WORDS];       /* Stacked R0-R3, R12, LR, PC, xPSR, all zero when
+                                                 * FaultStat has a NVIC_FAULT_STACKING_MASK bit      */
+    uint32 ExcReturn;                           /* EXC_RETURN of the fault handler                   */
+    uint32 FaultStat;                           /* FAULTSTAT (CFSR)                                  */
+    uint32 HFaultStat;                          /* HFAULTSTAT (HFSR)                                 */
+    uint32 MmAddr;                              /* MMADDR (MMFAR), valid with FAULTSTAT.MMARV        */
+    uint32 FaultAddr;                           /* FAULTADDR (BFAR), valid with FAULTSTAT.BFARV      */
+} NVIC_FaultRecordType;
+
+/* Called from the fault handler after the capture with the record and the live
+ * stacked frame, returns the action to take. To recover from a precise fault the
+ * hook stores the resume address in Frame[NVIC_FAULT_FRAME_PC]. After a fault on
+ * stacking Frame is a zeroed copy instead, and the fault resets whatever the hook returns */
+typedef NVIC_FaultActionType (*NVIC_FaultHookType)(const NVIC_FaultRecordType *Record, uint32 *Frame);
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES                                                         *
+ *******************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************************************************************
+ * Service Name: NVIC_Fault_Format
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Record - Fault record to decode
+ *                  Buffer_Size - Size of Buffer in bytes
+ * Parameters (inout): None
+ * Parameters (out): Buffer - NUL terminated report
+ * Return value: uint32 - Length of the report, truncated to Buffer_Size - 1
+ * Description: Function to turn a fault record into a readable multi-line report
+ *              naming the fault, its causes, the faulting address and the frame.
+ *              Has no register access, builds on the host (NVIC_FaultDecode.c)
+ **********************************************************************/
+uint32 NVIC_Fault_Format(const NVIC_FaultRecordType *Record, char *Buffer, uint32 Buffer_Size);
+
+#if NVIC_FAULT_ENABLE
+
+/*********************************************************************
+ * Service Name: NVIC_Fault_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to format the fault ring unless it already holds valid
+ *              records from before the last reset. The handlers below must be the
+ *              fault vectors (startup table or NVIC_SetExceptionHandler)
+ **********************************************************************/
+void NVIC_Fault_Init(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Fault_Clear
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to discard every record of the fault ring
+ **********************************************************************/
+void NVIC_Fault_Clear(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Fault_GetCount
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Faults recorded since the ring was formatted
+ * Description: Function to get the number of faults recorded, only the last
+ *              NVIC_FAULT_RING_SIZE of them are kept
+ **********************************************************************/
+uint32 NVIC_Fault_GetCount(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Fault_GetRecord
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Age - 0 for the latest fault, 1 for the one before, ...
+ * Parameters (inout): None
+ * Parameters (out): Record - Copy of the fault record
+ * Return value: boolean - TRUE if the record exists
+ * Description: Function to read a record of the fault ring
+ **********************************************************************/
+boolean NVIC_Fault_GetRecord(uint32 Age, NVIC_FaultRecordType *Record);
+
+/*********************************************************************
+ * Service Name: NVIC_Fault_SetHook
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Hook - Function deciding the action after a capture, NULL_PTR
+ *                         to use the NVIC_FAULT_xxx_ACTION configuration
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to install the fault policy hook, it runs in the fault handler
+ **********************************************************************/
+void NVIC_Fault_SetHook(NVIC_FaultHookType Hook);
+
+/*********************************************************************
+ * Service Name: NVIC_Fault_Capture
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Exc_Return - EXC_RETURN value of the fault handler
+ *                  Kind - NVIC_ExceptionType of the fault
+ * Parameters (inout): Frame - Stacked exception frame of the faulting context
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function the naked handlers branch to: records the fault in a fixed
+ *              number of loads and stores, then resets or returns as decided by
+ *              the hook or the configuration. A recover that would return to the
+ *              faulting instruction, or from a fault on stacking, resets instead
+ **********************************************************************/
+void NVIC_Fault_Capture(uint32 *Frame, uint32 Exc_Return, uint32 Kind);
+
+#ifndef NVIC_HOST_SIM
+
+/* Fault vectors: pick the active stack pointer from EXC_RETURN and branch to NVIC_Fault_Capture */
+void NVIC_Fault_HardFaultHandler(void);
+void NVIC_Fault_MemFaultHandler(void);
+void NVIC_Fault_BusFaultHandler(void);
+void NVIC_Fault_UsageFaultHandler(void);
+
+#endif /* NVIC_HOST_SIM */
+
+#endif /* NVIC_FAULT_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_FAULT_H_ */
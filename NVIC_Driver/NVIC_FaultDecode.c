@@ -0,0 +1,156 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_FaultDecode.c
+ *
+ * Description: Fault record decoder of the ARM Cortex M4 NVIC driver. Has no register
+ *              access, so it is linked into the target image or built on the host to
+ *              decode fault records dumped from retained RAM.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include "NVIC_Fault.h"
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+typedef struct
+{
+    uint32 Mask;
+    const char *Text;
+} NVIC_FaultCauseType;
+
+/* FAULTSTAT and HFAULTSTAT causes in report order */
+static const NVIC_FaultCauseType NVIC_FaultStatCauses[] = {
+    { FAULTSTAT_IERR_MASK,      "MemManage: instruction access violation" },
+    { FAULTSTAT_DERR_MASK,      "MemManage: data access violation" },
+    { FAULTSTAT_MUSTKE_MASK,    "MemManage: fault on exception return unstacking" },
+    { FAULTSTAT_MSTKE_MASK,     "MemManage: fault on exception entry stacking" },
+    { FAULTSTAT_MLSPERR_MASK,   "MemManage: fault on lazy FPU state preservation" },
+    { FAULTSTAT_IBUS_MASK,      "Bus: instruction fetch error" },
+    { FAULTSTAT_PRECISE_MASK,   "Bus: precise data access error" },
+    { FAULTSTAT_IMPRE_MASK,     "Bus: imprecise data access error (stacked PC is after the access)" },
+    { FAULTSTAT_BUSTKE_MASK,    "Bus: fault on exception return unstacking" },
+    { FAULTSTAT_BSTKE_MASK,     "Bus: fault on exception entry stacking" },
+    { FAULTSTAT_BLSPERR_MASK,   "Bus: fault on lazy FPU state preservation" },
+    { FAULTSTAT_UNDEF_MASK,     "Usage: undefined instruction" },
+    { FAULTSTAT_INVSTAT_MASK,   "Usage: invalid state (Thumb bit clear)" },
+    { FAULTSTAT_INVPC_MASK,     "Usage: invalid EXC_RETURN on exception return" },
+    { FAULTSTAT_NOCP_MASK,      "Usage: coprocessor access while disabled" },
+    { FAULTSTAT_UNALIGN_MASK,   "Usage: unaligned access" },
+    { FAULTSTAT_DIV0_MASK,      "Usage: divide by zero" },
+};
+
+static const NVIC_FaultCauseType NVIC_HFaultStatCauses[] = {
+    { HFAULTSTAT_VECT_MASK,     "Hard: vector table read error" },
+    { HFAULTSTAT_FORCED_MASK,   "Hard: escalated from a configurable fault" },
+    { (uint32)HFAULTSTAT_DBG_MASK, "Hard: debug event" },
+};
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+/* Append to the report, keeping the length of what did fit. Format is always a
+ * literal: the decoded texts are passed as "%s" arguments */
+static void NVIC_Fault_Append(char *Buffer, uint32 Buffer_Size, uint32 *Length, const char *Format, ...)
+    __attribute__((format(printf, 4, 5)));
+
+static void NVIC_Fault_Append(char *Buffer, uint32 Buffer_Size, uint32 *Length, const char *Format, ...) {
+    va_list Args;
+    int Written;
+    if (*Length + 1U >= Buffer_Size) {
+        return;
+    }
+    va_start(Args, Format);
+    Written = vsnprintf(Buffer + *Length, Buffer_Size - *Length, Format, Args);
+    va_end(Args);
+    if (Written < 0) {
+        return;
+    }
+    *Length += ((uint32)Written < (Buffer_Size - *Length)) ? (uint32)Written : (Buffer_Size - *Length - 1U);
+}
+
+static const char *NVIC_Fault_KindName(uint32 Kind) {
+    switch (Kind) {
+        case EXCEPTION_HARD_FAULT_TYPE:
+            return "Hard Fault";
+        case EXCEPTION_MEM_FAULT_TYPE:
+            return "MemManage Fault";
+        case EXCEPTION_BUS_FAULT_TYPE:
+            return "Bus Fault";
+        case EXCEPTION_USAGE_FAULT_TYPE:
+            return "Usage Fault";
+        default:
+            return "Unknown Fault";
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Fault_Format
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Record - Fault record to decode
+ *                  Buffer_Size - Size of Buffer in bytes
+ * Parameters (inout): None
+ * Parameters (out): Buffer - NUL terminated report
+ * Return value: uint32 - Length of the report, truncated to Buffer_Size - 1
+ * Description: Function to turn a fault record into a readable multi-line report
+ *              naming the fault, its causes, the faulting address and the frame.
+ *              Has no register access, builds on the host (NVIC_FaultDecode.c)
+ **********************************************************************/
+uint32 NVIC_Fault_Format(const NVIC_FaultRecordType *Record, char *Buffer, uint32 Buffer_Size) {
+    uint32 Length = 0;
+    uint32 Index;
+
+    if ((Record == NULL_PTR) || (Buffer == NULL_PTR) || (Buffer_Size == 0U)) {
+        return 0;
+    }
+    Buffer[0] = '\0';
+
+    NVIC_Fault_Append(Buffer, Buffer_Size, &Length, "Fault #%lu: %s at PC 0x%08lX (%s)\n",
+                      (unsigned long)Record->Sequence, NVIC_Fault_KindName(Record->Kind),
+                      (unsigned long)Record->Frame[NVIC_FAULT_FRAME_PC],
+                      ((Record->ExcReturn & 0x4UL) != 0) ? "thread stack PSP" : "main stack MSP");
+
+    for (Index = 0; Index < (sizeof(NVIC_HFaultStatCauses) / sizeof(NVIC_HFaultStatCauses[0])); Index++) {
+        if ((Record->HFaultStat & NVIC_HFaultStatCauses[Index].Mask) != 0) {
+            NVIC_Fault_Append(Buffer, Buffer_Size, &Length, "  %s\n", NVIC_HFaultStatCauses[Index].Text);
+        }
+    }
+    for (Index = 0; Index < (sizeof(NVIC_FaultStatCauses) / sizeof(NVIC_FaultStatCauses[0])); Index++) {
+        if ((Record->FaultStat & NVIC_FaultStatCauses[Index].Mask) != 0) {
+            NVIC_Fault_Append(Buffer, Buffer_Size, &Length, "  %s\n", NVIC_FaultStatCauses[Index].Text);
+        }
+    }
+    if ((Record->FaultStat & FAULTSTAT_MMARV_MASK) != 0) {
+        NVIC_Fault_Append(Buffer, Buffer_Size, &Length, "  MemManage address 0x%08lX\n", (unsigned long)Record->MmAddr);
+    }
+    if ((Record->FaultStat & FAULTSTAT_BFARV_MASK) != 0) {
+        NVIC_Fault_Append(Buffer, Buffer_Size, &Length, "  Bus fault address 0x%08lX\n", (unsigned long)Record->FaultAddr);
+    }
+
+    if ((Record->FaultStat & NVIC_FAULT_STACKING_MASK) != 0) {
+        NVIC_Fault_Append(Buffer, Buffer_Size, &Length, "  Frame not captured, the fault hit its stacking\n");
+    } else {
+        NVIC_Fault_Append(Buffer, Buffer_Size, &Length, "  R0  0x%08lX  R1 0x%08lX  R2 0x%08lX  R3   0x%08lX\n",
+                          (unsigned long)Record->Frame[NVIC_FAULT_FRAME_R0], (unsigned long)Record->Frame[NVIC_FAULT_FRAME_R1],
+                          (unsigned long)Record->Frame[NVIC_FAULT_FRAME_R2], (unsigned long)Record->Frame[NVIC_FAULT_FRAME_R3]);
+        NVIC_Fault_Append(Buffer, Buffer_Size, &Length, "  R12 0x%08lX  LR 0x%08lX  PC 0x%08lX  xPSR 0x%08lX\n",
+                          (unsigned long)Record->Frame[NVIC_FAULT_FRAME_R12], (unsigned long)Record->Frame[NVIC_FAULT_FRAME_LR],
+                          (unsigned long)Record->Frame[NVIC_FAULT_FRAME_PC], (unsigned long)Record->Frame[NVIC_FAULT_FRAME_XPSR]);
+    }
+    NVIC_Fault_Append(Buffer, Buffer_Size, &Length, "  CFSR 0x%08lX  HFSR 0x%08lX  EXC_RETURN 0x%08lX\n",
+                      (unsigned long)Record->FaultStat, (unsigned long)Record->HFaultStat, (unsigned long)Record->ExcReturn);
+    return Length;
+}
@@ -0,0 +1,317 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Fpu.c
+ *
+ * Description: Source file for the FPU context stacking control of the ARM Cortex M4 NVIC
+ *              driver.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+
+#include "NVIC_Fpu.h"
+#include "NVIC_Regs.h"
+
+/* Every FPU-free entry must name an implemented, non-reserved IRQ */
+#define NVIC_FPU_CFG_CHECK(IRQ_Num) \
+    typedef char NVIC_FpuCheck_##IRQ_Num[NVIC_IRQ_IS_VALID(IRQ_Num) ? 1 : -1];
+
+NVIC_CFG_FPU_FREE_TABLE(NVIC_FPU_CFG_CHECK)
+
+#define NVIC_FPU_CFG_ADD(IRQ_Num)            NVIC_IRQ_MASK_ADD(NVIC_FpuFree, (IRQ_Num));
+
+/* FPCCR bits selecting the stacking mode */
+#define NVIC_FPU_STACKING_MASK               (FPCCR_ASPEN_MASK | FPCCR_LSPEN_MASK)
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+/* IRQs whose handlers are declared FPU-free */
+static NVIC_IRQMaskType NVIC_FpuFree;
+
+/* FPCCR image of each NVIC_FpuStackingType */
+static const uint32 NVIC_FpuStackingBits[] = {
+    0UL,                                        /* NVIC_FPU_STACKING_NONE */
+    FPCCR_ASPEN_MASK,                           /* NVIC_FPU_STACKING_FULL */
+    FPCCR_ASPEN_MASK | FPCCR_LSPEN_MASK,        /* NVIC_FPU_STACKING_LAZY */
+};
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+/*********************************************************************
+ * Service Name: NVIC_Fpu_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - FALSE if NVIC_FPU_STACKING was refused and FPCCR left unchanged
+ * Description: Function to load the FPU-free IRQs of NVIC_Cfg.h and program the
+ *              configured stacking mode. Call after the IRQs are configured
+ **********************************************************************/
+boolean NVIC_Fpu_Init(void) {
+    uint32 Index;
+    for (Index = 0; Index < NVIC_IRQ_REG_COUNT; Index++) {
+        NVIC_FpuFree.Words[Index] = 0;
+    }
+    NVIC_CFG_FPU_FREE_TABLE(NVIC_FPU_CFG_ADD)
+    return NVIC_Fpu_SetStacking(NVIC_FPU_STACKING);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Fpu_SetStacking
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Mode - FP state preservation on exception entry
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - FALSE if refused: NVIC_FPU_STACKING_NONE while an IRQ not
+ *               declared FPU-free is enabled, or an unknown mode
+ * Description: Function to program FPCCR.ASPEN/LSPEN. Call from thread mode, the
+ *              IRQs enabled afterwards under NVIC_FPU_STACKING_NONE must be FPU-free
+ *              as well (NVIC_Fpu_GetUnsafeIRQs), so must the system exception handlers
+ **********************************************************************/
+boolean NVIC_Fpu_SetStacking(NVIC_FpuStackingType Mode) {
+    uint32 Fpccr;
+    if ((uint32)Mode > (uint32)NVIC_FPU_STACKING_LAZY) {
+        return FALSE;
+    }
+    if ((Mode == NVIC_FPU_STACKING_NONE) && (NVIC_Fpu_GetUnsafeIRQs(NULL_PTR) == FALSE)) {
+        return FALSE;
+    }
+    Fpccr = NVIC_READ32(NVIC_FPU_FPCCR_ADDR);
+    if ((Fpccr & NVIC_FPU_STACKING_MASK) != NVIC_FpuStackingBits[Mode]) {
+        NVIC_WRITE32(NVIC_FPU_FPCCR_ADDR, (Fpccr & ~NVIC_FPU_STACKING_MASK) | NVIC_FpuStackingBits[Mode]);
+        NVIC_DSB();
+        NVIC_ISB();
+    }
+    return TRUE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Fpu_GetStacking
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_FpuStackingType - Stacking mode programmed in FPCCR
+ * Description: Function to get the FP state preservation mode
+ **********************************************************************/
+NVIC_FpuStackingType NVIC_Fpu_GetStacking(void) {
+    uint32 Fpccr = NVIC_READ32(NVIC_FPU_FPCCR_ADDR);
+    if ((Fpccr & FPCCR_ASPEN_MASK) == 0) {
+        return NVIC_FPU_STACKING_NONE;
+    }
+    return ((Fpccr & FPCCR_LSPEN_MASK) != 0) ? NVIC_FPU_STACKING_LAZY : NVIC_FPU_STACKING_FULL;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Fpu_DeclareFree
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ *                  Fpu_Free - TRUE if the handler never executes a floating-point instruction
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - FALSE if refused: invalid IRQ, or withdrawing the declaration
+ *               of an enabled IRQ under NVIC_FPU_STACKING_NONE
+ * Description: Function to declare whether an IRQ handler uses the FPU
+ **********************************************************************/
+boolean NVIC_Fpu_DeclareFree(NVIC_IRQType IRQ_Num, boolean Fpu_Free) {
+    if (!NVIC_IRQ_IS_VALID(IRQ_Num)) {
+        return FALSE;
+    }
+    if (Fpu_Free == TRUE) {
+        NVIC_IRQ_MASK_ADD(NVIC_FpuFree, IRQ_Num);
+        return TRUE;
+    }
+    if ((NVIC_Fpu_GetStacking() == NVIC_FPU_STACKING_NONE) && (NVIC_IsIRQEnabled(IRQ_Num) == TRUE)) {
+        return FALSE;
+    }
+    NVIC_IRQ_MASK_REMOVE(NVIC_FpuFree, IRQ_Num);
+    return TRUE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Fpu_IsFree
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the IRQ handler is declared FPU-free
+ * Description: Function to check the FPU-free declaration of an IRQ
+ **********************************************************************/
+boolean NVIC_Fpu_IsFree(NVIC_IRQType IRQ_Num) {
+    if ((uint32)IRQ_Num >= NVIC_IRQ_COUNT) {
+        return FALSE;
+    }
+    return ((NVIC_FpuFree.Words[NVIC_IRQ_WORD(IRQ_Num)] & NVIC_IRQ_BIT(IRQ_Num)) != 0) ? TRUE : FALSE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Fpu_GetUnsafeIRQs
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): Unsafe_Mask - Enabled IRQs not declared FPU-free, may be NULL_PTR
+ * Return value: boolean - TRUE if every enabled IRQ is FPU-free
+ * Description: Function to check whether NVIC_FPU_STACKING_NONE is safe
+ **********************************************************************/
+boolean NVIC_Fpu_GetUnsafeIRQs(NVIC_IRQMaskType *Unsafe_Mask) {
+    boolean Safe = TRUE;
+    uint32 RegIndex;
+    uint32 Candidates;
+    uint32 Bit;
+
+    for (RegIndex = 0; RegIndex < NVIC_IRQ_REG_COUNT; RegIndex++) {
+        if (Unsafe_Mask != NULL_PTR) {
+            Unsafe_Mask->Words[RegIndex] = 0;
+        }
+        /* Only the IRQs that are not declared FPU-free need their enable checked */
+        Candidates = NVIC_DEVICE_VALID_IRQ_WORD(RegIndex) & ~NVIC_FpuFree.Words[RegIndex];
+        for (Bit = 0; Candidates != 0; Bit++, Candidates >>= 1) {
+            if (((Candidates & 1UL) != 0) && (NVIC_IsIRQEnabled((NVIC_IRQType)((RegIndex << 5) + Bit)) == TRUE)) {
+                if (Unsafe_Mask != NULL_PTR) {
+                    Unsafe_Mask->Words[RegIndex] |= (1UL << Bit);
+                }
+                Safe = FALSE;
+            }
+        }
+    }
+    return Safe;
+}
+
+#if NVIC_FPU_BENCH_ENABLE
+
+#ifdef NVIC_HOST_SIM
+/* The simulator does not take exceptions by itself */
+#define NVIC_FPU_BENCH_TAKE(IRQ_Num)         ((void)NVIC_Sim_TakeIRQ((uint32)(IRQ_Num)))
+#else
+/* The exception is taken once the SWTRIG store completes */
+#define NVIC_FPU_BENCH_TAKE(IRQ_Num)         do { NVIC_DSB(); NVIC_ISB(); } while (0)
+#endif
+
+static volatile uint32 NVIC_FpuBenchEntryStamp;
+static volatile uint32 NVIC_FpuBenchExitStamp;
+
+static void NVIC_Fpu_BenchFreeHandler(void) {
+    NVIC_FpuBenchEntryStamp = NVIC_DWT_NOW();
+    NVIC_FpuBenchExitStamp = NVIC_DWT_NOW();
+}
+
+/* The first FP instruction performs the deferred push of a lazily stacked frame */
+static void NVIC_Fpu_BenchFpuHandler(void) {
+    NVIC_FPU_TOUCH();
+    NVIC_FpuBenchEntryStamp = NVIC_DWT_NOW();
+    NVIC_FpuBenchExitStamp = NVIC_DWT_NOW();
+}
+
+/* Trigger the benchmark IRQ from a thread owning FP state and time both edges */
+static void NVIC_Fpu_BenchRun(NVIC_HandlerType Handler, uint32 Overhead, uint32 *Entry_Cycles, uint32 *Exit_Cycles) {
+    uint32 Start;
+    uint32 End;
+
+    NVIC_SetHandler(NVIC_FPU_BENCH_IRQ, Handler);
+    NVIC_FPU_TOUCH();
+    Start = NVIC_DWT_NOW();
+    NVIC_TriggerIRQ(NVIC_FPU_BENCH_IRQ);
+    NVIC_FPU_BENCH_TAKE(NVIC_FPU_BENCH_IRQ);
+    End = NVIC_DWT_NOW();
+
+    *Entry_Cycles = NVIC_FpuBenchEntryStamp - Start;
+    *Exit_Cycles = End - NVIC_FpuBenchExitStamp;
+    *Entry_Cycles = (*Entry_Cycles > Overhead) ? (*Entry_Cycles - Overhead) : 0;
+    *Exit_Cycles = (*Exit_Cycles > Overhead) ? (*Exit_Cycles - Overhead) : 0;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Fpu_Benchmark
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): Results - Entry/exit cycles of NONE, FULL and LAZY stacking
+ * Return value: boolean - FALSE if the FPU is not enabled in CPACR
+ * Description: Function to trigger NVIC_FPU_BENCH_IRQ from an FP-owning thread under
+ *              each stacking mode and time it with the DWT cycle counter. Needs the
+ *              RAM vector table (NVIC_RelocateVectorTable) and interrupts unmasked,
+ *              on the host the simulator cost model takes the IRQ. Enabled IRQs not
+ *              declared FPU-free are masked during the run. The stacking mode and
+ *              the IRQ handler, priority and enable are restored afterwards
+ **********************************************************************/
+boolean NVIC_Fpu_Benchmark(NVIC_FpuBenchResultType Results[NVIC_FPU_BENCH_MODE_COUNT]) {
+    static const NVIC_FpuStackingType Modes[NVIC_FPU_BENCH_MODE_COUNT] = {
+        NVIC_FPU_STACKING_NONE, NVIC_FPU_STACKING_FULL, NVIC_FPU_STACKING_LAZY
+    };
+    NVIC_FpuStackingType SavedMode;
+    NVIC_HandlerType SavedHandler;
+    NVIC_IRQPriorityType SavedPriority;
+    boolean SavedEnabled;
+    NVIC_IRQMaskType Unsafe;
+    NVIC_MaskTokenType Token;
+    uint32 Overhead;
+    uint32 Index;
+
+    if ((Results == NULL_PTR) ||
+        ((NVIC_READ32(NVIC_SYSTEM_CPACR_ADDR) & CPACR_FPU_ACCESS_MASK) != CPACR_FPU_ACCESS_MASK)) {
+        return FALSE;
+    }
+    NVIC_DWT_Start();
+
+    SavedMode = NVIC_Fpu_GetStacking();
+    SavedHandler = NVIC_GetHandler(NVIC_FPU_BENCH_IRQ);
+    SavedPriority = NVIC_GetPriorityIRQ(NVIC_FPU_BENCH_IRQ);
+    SavedEnabled = NVIC_IsIRQEnabled(NVIC_FPU_BENCH_IRQ);
+    NVIC_DisableIRQ(NVIC_FPU_BENCH_IRQ);
+    NVIC_SetPriorityIRQ(NVIC_FPU_BENCH_IRQ, NVIC_PRIORITY_0);
+
+    /* The benchmark handlers are FPU-free by construction: the application IRQs that
+     * are not stay masked (pending, not lost) for the run, so NONE is accepted too */
+    (void)NVIC_Fpu_GetUnsafeIRQs(&Unsafe);
+    Token = NVIC_MaskSet(&Unsafe);
+
+    /* Cost of reading the cycle counter, removed from every edge */
+    Overhead = NVIC_DWT_NOW();
+    Overhead = NVIC_DWT_NOW() - Overhead;
+
+    for (Index = 0; Index < NVIC_FPU_BENCH_MODE_COUNT; Index++) {
+        Results[Index].Mode = Modes[Index];
+        Results[Index].EntryCycles = 0;
+        Results[Index].ExitCycles = 0;
+        Results[Index].FpuEntryCycles = 0;
+        Results[Index].FpuExitCycles = 0;
+        Results[Index].Valid = NVIC_Fpu_SetStacking(Modes[Index]);
+        if (Results[Index].Valid == FALSE) {
+            continue;
+        }
+        NVIC_EnableIRQ(NVIC_FPU_BENCH_IRQ);
+        NVIC_Fpu_BenchRun(NVIC_Fpu_BenchFreeHandler, Overhead, &Results[Index].EntryCycles, &Results[Index].ExitCycles);
+        if (Modes[Index] != NVIC_FPU_STACKING_NONE) {
+            NVIC_Fpu_BenchRun(NVIC_Fpu_BenchFpuHandler, Overhead, &Results[Index].FpuEntryCycles, &Results[Index].FpuExitCycles);
+        }
+        NVIC_DisableIRQ(NVIC_FPU_BENCH_IRQ);
+    }
+
+    NVIC_SetHandler(NVIC_FPU_BENCH_IRQ, SavedHandler);
+    NVIC_SetPriorityIRQ(NVIC_FPU_BENCH_IRQ, SavedPriority);
+    (void)NVIC_Fpu_SetStacking(SavedMode);
+    NVIC_UnmaskSet(&Token);
+    if (SavedEnabled == TRUE) {
+        NVIC_EnableIRQ(NVIC_FPU_BENCH_IRQ);
+    }
+    return TRUE;
+}
+
+#endif /* NVIC_FPU_BENCH_ENABLE */
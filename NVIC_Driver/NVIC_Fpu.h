@@ -0,0 +1,177 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Fpu.h
+ *
+ * Description: Header file for the FPU context stacking control of the ARM Cortex M4 NVIC
+ *              driver. Selects how FPCCR preserves the floating-point state on exception
+ *              entry and keeps the set of IRQs whose handlers never touch the FPU, so the
+ *              26-word extended frame is only paid where it is needed.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_FPU_H_
+#define NVIC_FPU_H_
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+#include "std_types.h"
+#include "NVIC.h"
+#include "NVIC_Cfg.h"
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+#define FPCCR_ASPEN_MASK                     0x80000000
+#define FPCCR_LSPEN_MASK                     0x40000000
+#define FPCCR_LSPACT_MASK                    0x00000001
+
+/* CPACR.CP10/CP11 full access, the FPU is usable */
+#define CPACR_FPU_ACCESS_MASK                0x00F00000
+
+/* Stacking modes measured by NVIC_Fpu_Benchmark: NONE, FULL, LAZY */
+#define NVIC_FPU_BENCH_MODE_COUNT            3U
+
+/*******************************************************************************
+ * DATA TYPES DDECLERATIONS                                                    *
+ *******************************************************************************/
+
+/* FP state preservation on exception entry while the interrupted context owns FP state */
+typedef enum {
+    NVIC_FPU_STACKING_NONE = 0,     /* ASPEN=0: basic 8-word frame, handlers must not use the FPU          */
+    NVIC_FPU_STACKING_FULL = 1,     /* ASPEN=1 LSPEN=0: S0-S15/FPSCR stored at every entry (26 words)      */
+    NVIC_FPU_STACKING_LAZY = 2,     /* ASPEN=1 LSPEN=1: space reserved, stored on the handler's first FP use */
+} NVIC_FpuStackingType;
+
+/* Entry and exit cost of one stacking mode, in cycles. Entry runs from the SWTRIG
+ * store to the handler being ready to work, exit from its last instruction back to
+ * the interrupted thread, which always owns FP state */
+typedef struct {
+    NVIC_FpuStackingType Mode;
+    boolean Valid;              /* FALSE if NVIC_Fpu_SetStacking refused the mode                      */
+    uint32 EntryCycles;         /* FPU-free handler                                                    */
+    uint32 ExitCycles;
+    uint32 FpuEntryCycles;      /* Handler using the FPU, includes a lazy push. 0 for NONE             */
+    uint32 FpuExitCycles;
+} NVIC_FpuBenchResultType;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES                                                         *
+ *******************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************************************************************
+ * Service Name: NVIC_Fpu_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - FALSE if NVIC_FPU_STACKING was refused and FPCCR left unchanged
+ * Description: Function to load the FPU-free IRQs of NVIC_Cfg.h and program the
+ *              configured stacking mode. Call after the IRQs are configured
+ **********************************************************************/
+boolean NVIC_Fpu_Init(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Fpu_SetStacking
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Mode - FP state preservation on exception entry
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - FALSE if refused: NVIC_FPU_STACKING_NONE while an IRQ not
+ *               declared FPU-free is enabled, or an unknown mode
+ * Description: Function to program FPCCR.ASPEN/LSPEN. Call from thread mode, the
+ *              IRQs enabled afterwards under NVIC_FPU_STACKING_NONE must be FPU-free
+ *              as well (NVIC_Fpu_GetUnsafeIRQs), so must the system exception handlers
+ **********************************************************************/
+boolean NVIC_Fpu_SetStacking(NVIC_FpuStackingType Mode);
+
+/*********************************************************************
+ * Service Name: NVIC_Fpu_GetStacking
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_FpuStackingType - Stacking mode programmed in FPCCR
+ * Description: Function to get the FP state preservation mode
+ **********************************************************************/
+NVIC_FpuStackingType NVIC_Fpu_GetStacking(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Fpu_DeclareFree
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ *                  Fpu_Free - TRUE if the handler never executes a floating-point instruction
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - FALSE if refused: invalid IRQ, or withdrawing the declaration
+ *               of an enabled IRQ under NVIC_FPU_STACKING_NONE
+ * Description: Function to declare whether an IRQ handler uses the FPU
+ **********************************************************************/
+boolean NVIC_Fpu_DeclareFree(NVIC_IRQType IRQ_Num, boolean Fpu_Free);
+
+/*********************************************************************
+ * Service Name: NVIC_Fpu_IsFree
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the IRQ handler is declared FPU-free
+ * Description: Function to check the FPU-free declaration of an IRQ
+ **********************************************************************/
+boolean NVIC_Fpu_IsFree(NVIC_IRQType IRQ_Num);
+
+/*********************************************************************
+ * Service Name: NVIC_Fpu_GetUnsafeIRQs
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): Unsafe_Mask - Enabled IRQs not declared FPU-free, may be NULL_PTR
+ * Return value: boolean - TRUE if every enabled IRQ is FPU-free
+ * Description: Function to check whether NVIC_FPU_STACKING_NONE is safe
+ **********************************************************************/
+boolean NVIC_Fpu_GetUnsafeIRQs(NVIC_IRQMaskType *Unsafe_Mask);
+
+#if NVIC_FPU_BENCH_ENABLE
+
+/*********************************************************************
+ * Service Name: NVIC_Fpu_Benchmark
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): Results - Entry/exit cycles of NONE, FULL and LAZY stacking
+ * Return value: boolean - FALSE if the FPU is not enabled in CPACR
+ * Description: Function to trigger NVIC_FPU_BENCH_IRQ from an FP-owning thread under
+ *              each stacking mode and time it with the DWT cycle counter. Needs the
+ *              RAM vector table (NVIC_RelocateVectorTable) and interrupts unmasked,
+ *              on the host the simulator cost model takes the IRQ. Enabled IRQs not
+ *              declared FPU-free are masked during the run. The stacking mode and
+ *              the IRQ handler, priority and enable are restored afterwards
+ **********************************************************************/
+boolean NVIC_Fpu_Benchmark(NVIC_FpuBenchResultType Results[NVIC_FPU_BENCH_MODE_COUNT]);
+
+#endif /* NVIC_FPU_BENCH_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_FPU_H_ */
@@ -0,0 +1,251 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Regs.h
+ *
+ * Description: Register map and register access layer for the ARM Cortex M4 NVIC driver.
+ *              Every load/store the driver issues to the NVIC and the System Control
+ *              Block goes through the access macros below, so the same driver source
+ *              runs either on the target or against the host register simulator
+ *              (build with NVIC_HOST_SIM defined).
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_REGS_H_
+#define NVIC_REGS_H_
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+#include "std_types.h"
+#include "NVIC_Cfg.h"
+#include "NVIC_Device.h"
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+/* Number of implemented IRQs, 32-bit ENn/DISn/PENDn words, 32-bit PRIn words and SYSPRIn words */
+#define NVIC_IRQ_COUNT                       NVIC_DEVICE_IRQ_COUNT
+#define NVIC_IRQ_REG_COUNT                   ((NVIC_IRQ_COUNT + 31U) >> 5)
+#define NVIC_PRI_REG_COUNT                   ((NVIC_IRQ_COUNT + 3U) >> 2)
+#define NVIC_SYSPRI_REG_COUNT                3U
+
+/* Base address of the System Control Space (SysTick, NVIC and SCB) */
+#define NVIC_SCS_BASE_ADDRESS                0xE000E000UL
+
+/* NVIC registers */
+#define NVIC_EN0_ADDR                        (NVIC_SCS_BASE_ADDRESS + 0x100UL)
+#define NVIC_DIS0_ADDR                       (NVIC_SCS_BASE_ADDRESS + 0x180UL)
+#define NVIC_PEND0_ADDR                      (NVIC_SCS_BASE_ADDRESS + 0x200UL)
+#define NVIC_UNPEND0_ADDR                    (NVIC_SCS_BASE_ADDRESS + 0x280UL)
+#define NVIC_ACTIVE0_ADDR                    (NVIC_SCS_BASE_ADDRESS + 0x300UL)
+#define NVIC_PRI0_ADDR                       (NVIC_SCS_BASE_ADDRESS + 0x400UL)
+#define NVIC_SWTRIG_ADDR                     (NVIC_SCS_BASE_ADDRESS + 0xF00UL)
+
+/* Address of the n-th register of a banked NVIC register group */
+#define NVIC_EN_ADDR(n)                      (NVIC_EN0_ADDR + ((uint32)(n) << 2))
+#define NVIC_DIS_ADDR(n)                     (NVIC_DIS0_ADDR + ((uint32)(n) << 2))
+#define NVIC_PEND_ADDR(n)                    (NVIC_PEND0_ADDR + ((uint32)(n) << 2))
+#define NVIC_UNPEND_ADDR(n)                  (NVIC_UNPEND0_ADDR + ((uint32)(n) << 2))
+#define NVIC_ACTIVE_ADDR(n)                  (NVIC_ACTIVE0_ADDR + ((uint32)(n) << 2))
+#define NVIC_PRI_ADDR(n)                     (NVIC_PRI0_ADDR + ((uint32)(n) << 2))
+#define NVIC_SYSTEM_PRI_ADDR(n)              (NVIC_SYSTEM_PRI1_ADDR + ((uint32)(n) << 2))
+
+/* System Control Block registers */
+#define NVIC_SYSTEM_INTCTRL_ADDR             (NVIC_SCS_BASE_ADDRESS + 0xD04UL)
+#define NVIC_SYSTEM_VTABLE_ADDR              (NVIC_SCS_BASE_ADDRESS + 0xD08UL)
+#define NVIC_SYSTEM_APINT_ADDR               (NVIC_SCS_BASE_ADDRESS + 0xD0CUL)
+#define NVIC_SYSTEM_SYSCTRL_ADDR             (NVIC_SCS_BASE_ADDRESS + 0xD10UL)
+#define NVIC_SYSTEM_CFGCTRL_ADDR             (NVIC_SCS_BASE_ADDRESS + 0xD14UL)
+#define NVIC_SYSTEM_PRI1_ADDR                (NVIC_SCS_BASE_ADDRESS + 0xD18UL)
+#define NVIC_SYSTEM_PRI2_ADDR                (NVIC_SCS_BASE_ADDRESS + 0xD1CUL)
+#define NVIC_SYSTEM_PRI3_ADDR                (NVIC_SCS_BASE_ADDRESS + 0xD20UL)
+#define NVIC_SYSTEM_SYSHNDCTRL_ADDR          (NVIC_SCS_BASE_ADDRESS + 0xD24UL)
+#define NVIC_SYSTEM_FAULTSTAT_ADDR           (NVIC_SCS_BASE_ADDRESS + 0xD28UL)
+#define NVIC_SYSTEM_HFAULTSTAT_ADDR          (NVIC_SCS_BASE_ADDRESS + 0xD2CUL)
+#define NVIC_SYSTEM_MMADDR_ADDR              (NVIC_SCS_BASE_ADDRESS + 0xD34UL)
+#define NVIC_SYSTEM_FAULTADDR_ADDR           (NVIC_SCS_BASE_ADDRESS + 0xD38UL)
+#define NVIC_SYSTEM_CPACR_ADDR               (NVIC_SCS_BASE_ADDRESS + 0xD88UL)
+#define NVIC_SYSTEM_DEMCR_ADDR               (NVIC_SCS_BASE_ADDRESS + 0xDFCUL)
+
+/* Floating-point extension registers */
+#define NVIC_FPU_FPCCR_ADDR                  (NVIC_SCS_BASE_ADDRESS + 0xF34UL)
+#define NVIC_FPU_FPCAR_ADDR                  (NVIC_SCS_BASE_ADDRESS + 0xF38UL)
+
+/* Data Watchpoint and Trace unit registers */
+#define NVIC_DWT_CTRL_ADDR                   0xE0001000UL
+#define NVIC_DWT_CYCCNT_ADDR                 0xE0001004UL
+
+/* CYCCNT only counts while DEMCR.TRCENA and DWT_CTRL.CYCCNTENA are both set */
+#define DEMCR_TRCENA_MASK                    0x01000000UL
+#define DWT_CTRL_CYCCNTENA_MASK              0x00000001UL
+
+/* Current value of the DWT cycle counter */
+#define NVIC_DWT_NOW()                       ((uint32)NVIC_READ32(NVIC_DWT_CYCCNT_ADDR))
+
+/*******************************************************************************
+ * REGISTER ACCESS LAYER                                                       *
+ *******************************************************************************/
+#ifdef NVIC_HOST_SIM
+
+#include "NVIC_Sim.h"
+
+#define NVIC_READ32(ADDR)                    NVIC_Sim_Read32((uint32)(ADDR))
+#define NVIC_WRITE32(ADDR, VALUE)            NVIC_Sim_Write32((uint32)(ADDR), (uint32)(VALUE))
+#define NVIC_READ8(ADDR)                     NVIC_Sim_Read8((uint32)(ADDR))
+#define NVIC_WRITE8(ADDR, VALUE)             NVIC_Sim_Write8((uint32)(ADDR), (uint8)(VALUE))
+
+#else
+
+#define NVIC_READ32(ADDR)                    (*((volatile uint32 *)(ADDR)))
+#define NVIC_WRITE32(ADDR, VALUE)            (*((volatile uint32 *)(ADDR)) = (uint32)(VALUE))
+#define NVIC_READ8(ADDR)                     (*((volatile uint8 *)(ADDR)))
+#define NVIC_WRITE8(ADDR, VALUE)             (*((volatile uint8 *)(ADDR)) = (uint8)(VALUE))
+
+#endif /* NVIC_HOST_SIM */
+
+/*******************************************************************************
+ * CORE REGISTER ACCESS                                                        *
+ *******************************************************************************/
+
+/* Compiler barrier, keeps the compiler from reordering memory accesses across it */
+#define NVIC_COMPILER_BARRIER()              __asm volatile ("" : : : "memory")
+
+#ifdef NVIC_HOST_SIM
+
+#define NVIC_GET_BASEPRI()                   NVIC_Sim_GetBasepri()
+#define NVIC_SET_BASEPRI(VALUE)              NVIC_Sim_SetBasepri((uint32)(VALUE))
+#define NVIC_SET_BASEPRI_MAX(VALUE)          NVIC_Sim_SetBasepriMax((uint32)(VALUE))
+#define NVIC_GET_PRIMASK()                   NVIC_Sim_GetPrimask()
+#define NVIC_SET_PRIMASK(VALUE)              NVIC_Sim_SetPrimask((uint32)(VALUE))
+#define NVIC_DSB()                           NVIC_COMPILER_BARRIER()
+#define NVIC_ISB()                           NVIC_COMPILER_BARRIER()
+
+/* Scheduling point ahead of every host atomic access. A stress test defines it to
+ * yield now and then, so preemptions land inside the lock-free windows even on a
+ * single core */
+#ifndef NVIC_HOST_PREEMPT_POINT
+#define NVIC_HOST_PREEMPT_POINT()            ((void)0)
+#endif
+
+#define NVIC_ATOMIC_CAS(ADDR, EXPECTED, DESIRED) \
+    (NVIC_HOST_PREEMPT_POINT(), NVIC_HostCompareAndSwap((ADDR), (uint32)(EXPECTED), (uint32)(DESIRED)))
+
+#define NVIC_ATOMIC_LOAD(ADDR)               (NVIC_HOST_PREEMPT_POINT(), __atomic_load_n((ADDR), __ATOMIC_ACQUIRE))
+#define NVIC_ATOMIC_STORE(ADDR, VALUE) \
+    do { NVIC_HOST_PREEMPT_POINT(); __atomic_store_n((ADDR), (uint32)(VALUE), __ATOMIC_RELEASE); } while (0)
+
+/* Host stand-in for one LDREX/STREX attempt, may fail spuriously like the target */
+static inline boolean NVIC_HostCompareAndSwap(volatile uint32 *Address, uint32 Expected, uint32 Desired) {
+    return __atomic_compare_exchange_n(Address, &Expected, Desired, 1, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? TRUE : FALSE;
+}
+#define NVIC_SET_VTABLE(TABLE)               NVIC_Sim_SetVectorTable((NVIC_SimHandlerType *)(TABLE))
+#define NVIC_FPU_TOUCH()                     NVIC_Sim_TouchFpu()
+#define NVIC_WFI()                           NVIC_Sim_WaitForInterrupt()
+#define NVIC_WFE()                           NVIC_Sim_WaitForEvent()
+#define NVIC_SEV()                           NVIC_Sim_SendEvent()
+
+#else
+
+/* BASEPRI/BASEPRI_MAX are only reachable through MRS/MSR, the "memory" clobber keeps
+ * the compiler from moving accesses to shared data across the threshold change */
+static inline uint32 NVIC_CoreGetBasepri(void) {
+    uint32 Value;
+    __asm volatile ("MRS %0, BASEPRI" : "=r" (Value));
+    return Value;
+}
+
+static inline void NVIC_CoreSetBasepri(uint32 Value) {
+    __asm volatile ("MSR BASEPRI, %0" : : "r" (Value) : "memory");
+}
+
+static inline void NVIC_CoreSetBasepriMax(uint32 Value) {
+    __asm volatile ("MSR BASEPRI_MAX, %0" : : "r" (Value) : "memory");
+}
+
+static inline uint32 NVIC_CoreGetPrimask(void) {
+    uint32 Value;
+    __asm volatile ("MRS %0, PRIMASK" : "=r" (Value));
+    return Value;
+}
+
+static inline void NVIC_CoreSetPrimask(uint32 Value) {
+    __asm volatile ("MSR PRIMASK, %0" : : "r" (Value) : "memory");
+}
+
+/* Aligned word accesses are single-copy atomic and a single core observes its own
+ * accesses in program order, so ordering only needs a compiler barrier */
+static inline uint32 NVIC_CoreLoadAcquire(volatile uint32 *Address) {
+    uint32 Value = *Address;
+    NVIC_COMPILER_BARRIER();
+    return Value;
+}
+
+static inline void NVIC_CoreStoreRelease(volatile uint32 *Address, uint32 Value) {
+    NVIC_COMPILER_BARRIER();
+    *Address = Value;
+}
+
+/* Single LDREX/STREX attempt: fails when the word differs from Expected or when
+ * the exclusive monitor was lost (any exception entry/return clears it), the
+ * caller retries with a fresh value */
+static inline boolean NVIC_CoreCompareAndSwap(volatile uint32 *Address, uint32 Expected, uint32 Desired) {
+    uint32 Current;
+    uint32 StoreFailed;
+    __asm volatile ("LDREX %0, [%1]" : "=r" (Current) : "r" (Address) : "memory");
+    if (Current != Expected) {
+        __asm volatile ("CLREX" : : : "memory");
+        return FALSE;
+    }
+    __asm volatile ("STREX %0, %2, [%1]" : "=&r" (StoreFailed) : "r" (Address), "r" (Desired) : "memory");
+    return (StoreFailed == 0) ? TRUE : FALSE;
+}
+
+#define NVIC_GET_BASEPRI()                   NVIC_CoreGetBasepri()
+#define NVIC_SET_BASEPRI(VALUE)              NVIC_CoreSetBasepri((uint32)(VALUE))
+#define NVIC_SET_BASEPRI_MAX(VALUE)          NVIC_CoreSetBasepriMax((uint32)(VALUE))
+#define NVIC_GET_PRIMASK()                   NVIC_CoreGetPrimask()
+#define NVIC_SET_PRIMASK(VALUE)              NVIC_CoreSetPrimask((uint32)(VALUE))
+#define NVIC_DSB()                           __asm volatile ("DSB" : : : "memory")
+#define NVIC_ISB()                           __asm volatile ("ISB" : : : "memory")
+#define NVIC_ATOMIC_CAS(ADDR, EXPECTED, DESIRED) \
+    NVIC_CoreCompareAndSwap((ADDR), (uint32)(EXPECTED), (uint32)(DESIRED))
+#define NVIC_ATOMIC_LOAD(ADDR)               NVIC_CoreLoadAcquire((ADDR))
+#define NVIC_ATOMIC_STORE(ADDR, VALUE)       NVIC_CoreStoreRelease((ADDR), (uint32)(VALUE))
+#define NVIC_SET_VTABLE(TABLE)               NVIC_WRITE32(NVIC_SYSTEM_VTABLE_ADDR, (uint32)(TABLE))
+
+/* Executes one floating-point instruction: sets CONTROL.FPCA in thread mode and
+ * triggers the deferred push of a lazily stacked frame inside a handler */
+static inline void NVIC_CoreTouchFpu(void) {
+    uint32 Value;
+    __asm volatile (".fpu fpv4-sp-d16\n\tVMRS %0, FPSCR" : "=r" (Value) : : "memory");
+    (void)Value;
+}
+#define NVIC_FPU_TOUCH()                     NVIC_CoreTouchFpu()
+#define NVIC_WFI()                           __asm volatile ("WFI" : : : "memory")
+#define NVIC_WFE()                           __asm volatile ("WFE" : : : "memory")
+#define NVIC_SEV()                           __asm volatile ("SEV" : : : "memory")
+
+#endif /* NVIC_HOST_SIM */
+
+/* Short PRIMASK critical section that nests: the caller keeps the previous
+ * PRIMASK in SAVED and restores it on exit */
+#define NVIC_ENTER_CRITICAL(SAVED)           do { (SAVED) = NVIC_GET_PRIMASK(); NVIC_SET_PRIMASK(1U); } while (0)
+#define NVIC_EXIT_CRITICAL(SAVED)            NVIC_SET_PRIMASK((SAVED))
+
+/* Start the DWT cycle counter from its current value, for the modules timing with
+ * NVIC_DWT_NOW(). Enabling it again is harmless */
+static inline void NVIC_DWT_Start(void) {
+    NVIC_WRITE32(NVIC_SYSTEM_DEMCR_ADDR, NVIC_READ32(NVIC_SYSTEM_DEMCR_ADDR) | DEMCR_TRCENA_MASK);
+    NVIC_WRITE32(NVIC_DWT_CTRL_ADDR, NVIC_READ32(NVIC_DWT_CTRL_ADDR) | DWT_CTRL_CYCCNTENA_MASK);
+}
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_REGS_H_ */
@@ -0,0 +1,68 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Seqlock.h
+ *
+ * Description: Sequence counter guarding the statistics records of the ARM Cortex M4
+ *              NVIC driver (per-IRQ run times, wake-up latencies). A record has one
+ *              writer at a time, which never waits; readers copy it while the system
+ *              keeps running and retry when the copy may be torn.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_SEQLOCK_H_
+#define NVIC_SEQLOCK_H_
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+#include <string.h>
+#include "std_types.h"
+#include "NVIC_Regs.h"
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+/* Open an update of the record guarded by Sequence, which stays odd until
+ * NVIC_Seqlock_WriteEnd. The caller makes sure no other writer runs meanwhile */
+static inline void NVIC_Seqlock_WriteBegin(volatile uint32 *Sequence) {
+    (*Sequence)++;
+    NVIC_COMPILER_BARRIER();
+}
+
+static inline void NVIC_Seqlock_WriteEnd(volatile uint32 *Sequence) {
+    NVIC_COMPILER_BARRIER();
+    (*Sequence)++;
+}
+
+/* Copy the Size bytes of Record into Copy, up to Retries times until no update
+ * overlapped the copy. Returns FALSE, Copy possibly torn, if every attempt did */
+static inline boolean NVIC_Seqlock_Read(const volatile uint32 *Sequence, const void *Record, void *Copy,
+                                        uint32 Size, uint8 Retries) {
+    uint32 SequenceBefore;
+    uint8 Retry;
+
+    for (Retry = 0; Retry < Retries; Retry++) {
+        SequenceBefore = *Sequence;
+        if ((SequenceBefore & 1U) != 0) {
+            continue;
+        }
+        NVIC_COMPILER_BARRIER();
+        memcpy(Copy, Record, Size);
+        NVIC_COMPILER_BARRIER();
+        if (*Sequence == SequenceBefore) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_SEQLOCK_H_ */
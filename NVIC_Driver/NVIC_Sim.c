@@ -0,0 +1,1052 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Sim.c
+ *
+ * Description: Host-side simulator of the NVIC and System Control Block registers.
+ *              Models the set/clear semantics of the ENn/DISn and PENDn/UNPENDn
+ *              pairs, the implemented priority bits of PRIn and SYSPRI1-3, the
+ *              writable bits of SYSHNDCTRL and counts every load and store.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+
+#include "NVIC_Sim.h"
+#include "NVIC_Regs.h"
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+/* Implemented bits of the priority registers (NVIC_DEVICE_PRIORITY_BITS per field) */
+#define NVIC_SIM_PRI_BYTE_MASK               ((0xFFUL << (8U - NVIC_DEVICE_PRIORITY_BITS)) & 0xFFUL)
+#define NVIC_SIM_PRI_MASK                    (NVIC_SIM_PRI_BYTE_MASK * 0x01010101UL)
+#define NVIC_SIM_SYSPRI1_MASK                (NVIC_SIM_PRI_BYTE_MASK * 0x00010101UL)
+#define NVIC_SIM_SYSPRI2_MASK                (NVIC_SIM_PRI_BYTE_MASK * 0x01000000UL)
+#define NVIC_SIM_SYSPRI3_MASK                (NVIC_SIM_PRI_BYTE_MASK * 0x01010001UL)
+
+/* Writable bits of the remaining SCB registers */
+#define NVIC_SIM_SYSHNDCTRL_MASK             0x0007FD8BUL
+#define NVIC_SIM_SYSCTRL_MASK                0x00000016UL
+#define NVIC_SIM_CFGCTRL_MASK                0x0000031BUL
+#define NVIC_SIM_CFGCTRL_RESET               0x00000200UL
+#define NVIC_SIM_VTABLE_MASK                 0xFFFFFC00UL
+#define NVIC_SIM_BASEPRI_MASK                NVIC_SIM_PRI_BYTE_MASK
+
+/* APINT is only written when the VECTKEY field holds 0x05FA, it reads back as 0xFA05 */
+#define NVIC_SIM_APINT_WRITE_KEY             0x05FAUL
+#define NVIC_SIM_APINT_READ_KEY              0xFA050000UL
+#define NVIC_SIM_APINT_PRIGROUP_MASK         0x00000700UL
+#define NVIC_SIM_APINT_SYSRESETREQ           0x00000004UL
+
+/* INTCTRL set/clear-pending bits of PendSV and SysTick */
+#define NVIC_SIM_INTCTRL_PENDSV_SET          0x10000000UL
+#define NVIC_SIM_INTCTRL_PENDSV_CLEAR        0x08000000UL
+#define NVIC_SIM_INTCTRL_PENDST_SET          0x04000000UL
+#define NVIC_SIM_INTCTRL_PENDST_CLEAR        0x02000000UL
+
+/* FPCCR: reset value and writable bits (ASPEN, LSPEN, the xxRDY flags, USER, THREAD, LSPACT) */
+#define NVIC_SIM_FPCCR_ASPEN                 0x80000000UL
+#define NVIC_SIM_FPCCR_LSPEN                 0x40000000UL
+#define NVIC_SIM_FPCCR_LSPACT                0x00000001UL
+#define NVIC_SIM_FPCCR_RESET                 0xC0000000UL
+#define NVIC_SIM_FPCCR_MASK                  0xC000017BUL
+
+/* Vector table index of IRQ 0 */
+#define NVIC_SIM_IRQ_VECTOR_OFFSET           16U
+
+/* SYSCTRL (SCR) sleep controls */
+#define NVIC_SIM_SYSCTRL_SLEEPONEXIT         0x00000002UL
+#define NVIC_SIM_SYSCTRL_SLEEPDEEP           0x00000004UL
+#define NVIC_SIM_SYSCTRL_SEVONPEND           0x00000010UL
+
+/* INTCTRL (ICSR) status: no other exception active, and the highest priority pending IRQ */
+#define NVIC_SIM_INTCTRL_RETBASE             0x00000800UL
+#define NVIC_SIM_INTCTRL_VECPEND_BITS_POS    12U
+#define NVIC_SIM_INTCTRL_ISRPEND             0x00400000UL
+
+/* Wake-up cost model: cycles from the wake-up event until the core clock runs again.
+ * CYCCNT stops while the core sleeps, so only these cycles show up in it */
+#define NVIC_SIM_WAKE_CYCLES                 2U
+#define NVIC_SIM_DEEP_WAKE_CYCLES            20U
+
+/* Storage for registers that are not modelled individually (plain read/write) */
+#define NVIC_SIM_GENERIC_REG_COUNT           32U
+
+/* Word index of an address inside a banked register group, or NVIC_SIM_NO_INDEX */
+#define NVIC_SIM_NO_INDEX                    0xFFFFFFFFUL
+
+/*******************************************************************************
+ * DATA TYPES DDECLERATIONS                                                    *
+ *******************************************************************************/
+typedef struct
+{
+    uint32 Address;
+    uint32 Value;
+    boolean Used;
+} NVIC_SimGenericRegType;
+
+/* Stacking state of one simulated exception level */
+typedef struct
+{
+    boolean Extended;                   /* Extended frame allocated                  */
+    boolean FpUnpreserved;              /* Interrupted FP state is not preserved     */
+    NVIC_SimExceptionCostType Cost;
+} NVIC_SimFrameType;
+
+typedef struct
+{
+    uint32 Enable[NVIC_IRQ_REG_COUNT];
+    uint32 Pending[NVIC_IRQ_REG_COUNT];
+    uint32 Active[NVIC_IRQ_REG_COUNT];
+    uint32 Priority[NVIC_PRI_REG_COUNT];
+    uint32 IntCtrl;
+    uint32 VTable;
+    uint32 PriGroup;
+    uint32 SysCtrl;
+    uint32 CfgCtrl;
+    uint32 SysPri1;
+    uint32 SysPri2;
+    uint32 SysPri3;
+    uint32 SysHndCtrl;
+    uint32 FaultStat;
+    uint32 HFaultStat;
+    uint32 MmAddr;
+    uint32 FaultAddr;
+    uint32 ResetRequests;
+    uint32 Fpccr;
+    boolean Fpca;                       /* CONTROL.FPCA of the running context       */
+    uint32 FpCorruptions;
+    NVIC_SimExceptionCostType LastException;
+    boolean Asleep;                     /* Core halted by WFI/WFE or sleep-on-exit   */
+    boolean AsleepDeep;                 /* SLEEPDEEP was set when it went to sleep   */
+    boolean EventRegister;              /* WFE event register                        */
+    NVIC_SimSleepStatsType Sleep;
+    uint32 Demcr;
+    uint32 DwtCtrl;
+    uint32 CycCnt;
+    NVIC_SimHandlerType *VectorTable;
+    uint32 Primask;
+    uint32 Faultmask;
+    uint32 Basepri;
+    NVIC_SimGenericRegType Generic[NVIC_SIM_GENERIC_REG_COUNT];
+} NVIC_SimStateType;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+static NVIC_SimStateType NVIC_SimState;
+static NVIC_SimStatsType NVIC_SimStats;
+static boolean NVIC_SimInitialized = FALSE;
+static NVIC_SimFrameType *NVIC_SimFrame = NULL_PTR;
+
+/*******************************************************************************
+ * PRIVATE FUNCTION DEFINITIONS                                                *
+ *******************************************************************************/
+
+/* Implemented IRQ bits of the n-th ENn/DISn/PENDn/UNPENDn/ACTIVEn word */
+static uint32 NVIC_Sim_IRQWordMask(uint32 Index)
+{
+    uint32 FirstIRQ = Index * 32U;
+    if (FirstIRQ + 32U <= NVIC_IRQ_COUNT) {
+        return 0xFFFFFFFFUL;
+    }
+    return (1UL << (NVIC_IRQ_COUNT - FirstIRQ)) - 1UL;
+}
+
+/* Implemented priority bits of the n-th PRIn word */
+static uint32 NVIC_Sim_PriWordMask(uint32 Index)
+{
+    uint32 FirstIRQ = Index * 4U;
+    if (FirstIRQ + 4U <= NVIC_IRQ_COUNT) {
+        return NVIC_SIM_PRI_MASK;
+    }
+    return NVIC_SIM_PRI_MASK & ((1UL << ((NVIC_IRQ_COUNT - FirstIRQ) * 8U)) - 1UL);
+}
+
+/* Index of Address inside the group starting at Base with Count words */
+static uint32 NVIC_Sim_GroupIndex(uint32 Address, uint32 Base, uint32 Count)
+{
+    if ((Address >= Base) && (Address < (Base + (Count << 2)))) {
+        return (Address - Base) >> 2;
+    }
+    return NVIC_SIM_NO_INDEX;
+}
+
+static NVIC_SimGenericRegType *NVIC_Sim_GenericReg(uint32 Address)
+{
+    uint8 i;
+    for (i = 0; i < NVIC_SIM_GENERIC_REG_COUNT; i++) {
+        if ((NVIC_SimState.Generic[i].Used == TRUE) && (NVIC_SimState.Generic[i].Address == Address)) {
+            return &NVIC_SimState.Generic[i];
+        }
+    }
+    for (i = 0; i < NVIC_SIM_GENERIC_REG_COUNT; i++) {
+        if (NVIC_SimState.Generic[i].Used == FALSE) {
+            NVIC_SimState.Generic[i].Used = TRUE;
+            NVIC_SimState.Generic[i].Address = Address;
+            NVIC_SimState.Generic[i].Value = 0;
+            return &NVIC_SimState.Generic[i];
+        }
+    }
+    /* Out of generic registers: the simulator is sized too small for the caller */
+    return NULL_PTR;
+}
+
+static void NVIC_Sim_EnsureInitialized(void)
+{
+    if (NVIC_SimInitialized == FALSE) {
+        NVIC_Sim_Reset();
+    }
+}
+
+/* Sets pending bits, with SEVONPEND an IRQ entering the pending state is a WFE event */
+static void NVIC_Sim_Pend(uint32 Index, uint32 Bits)
+{
+    if (((Bits & ~NVIC_SimState.Pending[Index]) != 0) &&
+        ((NVIC_SimState.SysCtrl & NVIC_SIM_SYSCTRL_SEVONPEND) != 0)) {
+        NVIC_SimState.EventRegister = TRUE;
+    }
+    NVIC_SimState.Pending[Index] |= Bits;
+}
+
+/* Pending and enabled IRQ with the highest priority (lowest number on a tie), or NVIC_SIM_NO_INDEX */
+static uint32 NVIC_Sim_HighestPendingIRQ(void)
+{
+    uint32 Best = NVIC_SIM_NO_INDEX;
+    uint32 BestPriority = 0x100UL;
+    uint32 Priority;
+    uint32 IRQ_Num;
+
+    for (IRQ_Num = 0; IRQ_Num < NVIC_IRQ_COUNT; IRQ_Num++) {
+        if ((NVIC_SimState.Pending[IRQ_Num >> 5] & NVIC_SimState.Enable[IRQ_Num >> 5] & (1UL << (IRQ_Num & 31UL))) == 0) {
+            continue;
+        }
+        Priority = (NVIC_SimState.Priority[IRQ_Num >> 2] >> ((IRQ_Num & 3UL) << 3)) & 0xFFUL;
+        if (Priority < BestPriority) {
+            Best = IRQ_Num;
+            BestPriority = Priority;
+        }
+    }
+    return Best;
+}
+
+/* Live INTCTRL status bits: RETBASE, VECPEND and ISRPEND */
+static uint32 NVIC_Sim_IntCtrlStatus(void)
+{
+    uint32 Status = 0;
+    uint32 ActiveCount = 0;
+    uint32 Pending;
+    uint32 Index;
+    uint32 Bits;
+
+    for (Index = 0; Index < NVIC_IRQ_REG_COUNT; Index++) {
+        for (Bits = NVIC_SimState.Active[Index]; Bits != 0; Bits &= (Bits - 1UL)) {
+            ActiveCount++;
+        }
+    }
+    if (ActiveCount <= 1U) {
+        Status |= NVIC_SIM_INTCTRL_RETBASE;
+    }
+    Pending = NVIC_Sim_HighestPendingIRQ();
+    if (Pending != NVIC_SIM_NO_INDEX) {
+        Status |= ((Pending + NVIC_SIM_IRQ_VECTOR_OFFSET) << NVIC_SIM_INTCTRL_VECPEND_BITS_POS) | NVIC_SIM_INTCTRL_ISRPEND;
+    }
+    return Status;
+}
+
+/* Halts the simulated core, its cycle counter stops until the wake-up */
+static void NVIC_Sim_EnterSleep(void)
+{
+    NVIC_SimState.Asleep = TRUE;
+    NVIC_SimState.AsleepDeep = ((NVIC_SimState.SysCtrl & NVIC_SIM_SYSCTRL_SLEEPDEEP) != 0) ? TRUE : FALSE;
+    NVIC_SimState.Sleep.Sleeps++;
+    if (NVIC_SimState.AsleepDeep == TRUE) {
+        NVIC_SimState.Sleep.DeepSleeps++;
+    }
+}
+
+/* Restarts the simulated core after a wake-up event */
+static void NVIC_Sim_Wake(void)
+{
+    if (NVIC_SimState.Asleep == TRUE) {
+        NVIC_SimState.Asleep = FALSE;
+        NVIC_SimState.Sleep.Wakes++;
+        NVIC_Sim_AdvanceCycles((NVIC_SimState.AsleepDeep == TRUE) ? NVIC_SIM_DEEP_WAKE_CYCLES : NVIC_SIM_WAKE_CYCLES);
+    }
+}
+
+/* WFI/WFE wake-up: the highest priority pending IRQ is taken, with PRIMASK set the core only wakes */
+static void NVIC_Sim_WakeOnPending(void)
+{
+    uint32 IRQ_Num = NVIC_Sim_HighestPendingIRQ();
+    if (IRQ_Num == NVIC_SIM_NO_INDEX) {
+        return;
+    }
+    if (NVIC_SimState.Primask != 0) {
+        NVIC_Sim_Wake();
+    } else {
+        (void)NVIC_Sim_TakeIRQ(IRQ_Num);
+    }
+}
+
+/* Uncounted load implementing the read semantics of every simulated register */
+static uint32 NVIC_Sim_Load(uint32 Address)
+{
+    uint32 Index;
+    NVIC_SimGenericRegType *GenericReg;
+
+    if ((Index = NVIC_Sim_GroupIndex(Address, NVIC_EN0_ADDR, NVIC_IRQ_REG_COUNT)) != NVIC_SIM_NO_INDEX) {
+        return NVIC_SimState.Enable[Index];
+    }
+    if ((Index = NVIC_Sim_GroupIndex(Address, NVIC_DIS0_ADDR, NVIC_IRQ_REG_COUNT)) != NVIC_SIM_NO_INDEX) {
+        return NVIC_SimState.Enable[Index];
+    }
+    if ((Index = NVIC_Sim_GroupIndex(Address, NVIC_PEND0_ADDR, NVIC_IRQ_REG_COUNT)) != NVIC_SIM_NO_INDEX) {
+        return NVIC_SimState.Pending[Index];
+    }
+    if ((Index = NVIC_Sim_GroupIndex(Address, NVIC_UNPEND0_ADDR, NVIC_IRQ_REG_COUNT)) != NVIC_SIM_NO_INDEX) {
+        return NVIC_SimState.Pending[Index];
+    }
+    if ((Index = NVIC_Sim_GroupIndex(Address, NVIC_ACTIVE0_ADDR, NVIC_IRQ_REG_COUNT)) != NVIC_SIM_NO_INDEX) {
+        return NVIC_SimState.Active[Index];
+    }
+    if ((Index = NVIC_Sim_GroupIndex(Address, NVIC_PRI0_ADDR, NVIC_PRI_REG_COUNT)) != NVIC_SIM_NO_INDEX) {
+        return NVIC_SimState.Priority[Index];
+    }
+
+    switch (Address) {
+        case NVIC_SWTRIG_ADDR:
+            /* Write-only */
+            return 0;
+        case NVIC_SYSTEM_INTCTRL_ADDR:
+            return NVIC_SimState.IntCtrl | NVIC_Sim_IntCtrlStatus();
+        case NVIC_SYSTEM_VTABLE_ADDR:
+            return NVIC_SimState.VTable;
+        case NVIC_SYSTEM_APINT_ADDR:
+            return NVIC_SIM_APINT_READ_KEY | NVIC_SimState.PriGroup;
+        case NVIC_SYSTEM_SYSCTRL_ADDR:
+            return NVIC_SimState.SysCtrl;
+        case NVIC_SYSTEM_CFGCTRL_ADDR:
+            return NVIC_SimState.CfgCtrl;
+        case NVIC_SYSTEM_PRI1_ADDR:
+            return NVIC_SimState.SysPri1;
+        case NVIC_SYSTEM_PRI2_ADDR:
+            return NVIC_SimState.SysPri2;
+        case NVIC_SYSTEM_PRI3_ADDR:
+            return NVIC_SimState.SysPri3;
+        case NVIC_SYSTEM_SYSHNDCTRL_ADDR:
+            return NVIC_SimState.SysHndCtrl;
+        case NVIC_SYSTEM_FAULTSTAT_ADDR:
+            return NVIC_SimState.FaultStat;
+        case NVIC_SYSTEM_HFAULTSTAT_ADDR:
+            return NVIC_SimState.HFaultStat;
+        case NVIC_SYSTEM_MMADDR_ADDR:
+            return NVIC_SimState.MmAddr;
+        case NVIC_SYSTEM_FAULTADDR_ADDR:
+            return NVIC_SimState.FaultAddr;
+        case NVIC_SYSTEM_DEMCR_ADDR:
+            return NVIC_SimState.Demcr;
+        case NVIC_FPU_FPCCR_ADDR:
+            return NVIC_SimState.Fpccr;
+        case NVIC_DWT_CTRL_ADDR:
+            return NVIC_SimState.DwtCtrl;
+        case NVIC_DWT_CYCCNT_ADDR:
+            return NVIC_SimState.CycCnt;
+        default:
+            GenericReg = NVIC_Sim_GenericReg(Address);
+            return (GenericReg != NULL_PTR) ? GenericReg->Value : 0;
+    }
+}
+
+/* Uncounted store implementing the write semantics of every simulated register */
+static void NVIC_Sim_Store(uint32 Address, uint32 Value)
+{
+    uint32 Index;
+    NVIC_SimGenericRegType *GenericReg;
+
+    if ((Index = NVIC_Sim_GroupIndex(Address, NVIC_EN0_ADDR, NVIC_IRQ_REG_COUNT)) != NVIC_SIM_NO_INDEX) {
+        NVIC_SimState.Enable[Index] |= (Value & NVIC_Sim_IRQWordMask(Index));
+        return;
+    }
+    if ((Index = NVIC_Sim_GroupIndex(Address, NVIC_DIS0_ADDR, NVIC_IRQ_REG_COUNT)) != NVIC_SIM_NO_INDEX) {
+        NVIC_SimState.Enable[Index] &= ~Value;
+        return;
+    }
+    if ((Index = NVIC_Sim_GroupIndex(Address, NVIC_PEND0_ADDR, NVIC_IRQ_REG_COUNT)) != NVIC_SIM_NO_INDEX) {
+        NVIC_Sim_Pend(Index, Value & NVIC_Sim_IRQWordMask(Index));
+        return;
+    }
+    if ((Index = NVIC_Sim_GroupIndex(Address, NVIC_UNPEND0_ADDR, NVIC_IRQ_REG_COUNT)) != NVIC_SIM_NO_INDEX) {
+        NVIC_SimState.Pending[Index] &= ~Value;
+        return;
+    }
+    if ((Index = NVIC_Sim_GroupIndex(Address, NVIC_ACTIVE0_ADDR, NVIC_IRQ_REG_COUNT)) != NVIC_SIM_NO_INDEX) {
+        /* Read-only */
+        return;
+    }
+    if ((Index = NVIC_Sim_GroupIndex(Address, NVIC_PRI0_ADDR, NVIC_PRI_REG_COUNT)) != NVIC_SIM_NO_INDEX) {
+        NVIC_SimState.Priority[Index] = Value & NVIC_Sim_PriWordMask(Index);
+        return;
+    }
+
+    switch (Address) {
+        case NVIC_SWTRIG_ADDR:
+            Value &= 0xFFUL;
+            if (Value < NVIC_IRQ_COUNT) {
+                NVIC_Sim_Pend(Value >> 5, 1UL << (Value & 31UL));
+            }
+            break;
+        case NVIC_SYSTEM_INTCTRL_ADDR:
+            if ((Value & NVIC_SIM_INTCTRL_PENDSV_SET) != 0) {
+                NVIC_SimState.IntCtrl |= NVIC_SIM_INTCTRL_PENDSV_SET;
+            } else if ((Value & NVIC_SIM_INTCTRL_PENDSV_CLEAR) != 0) {
+                NVIC_SimState.IntCtrl &= ~NVIC_SIM_INTCTRL_PENDSV_SET;
+            }
+            if ((Value & NVIC_SIM_INTCTRL_PENDST_SET) != 0) {
+                NVIC_SimState.IntCtrl |= NVIC_SIM_INTCTRL_PENDST_SET;
+            } else if ((Value & NVIC_SIM_INTCTRL_PENDST_CLEAR) != 0) {
+                NVIC_SimState.IntCtrl &= ~NVIC_SIM_INTCTRL_PENDST_SET;
+            }
+            break;
+        case NVIC_SYSTEM_VTABLE_ADDR:
+            NVIC_SimState.VTable = Value & NVIC_SIM_VTABLE_MASK;
+            break;
+        case NVIC_SYSTEM_APINT_ADDR:
+            if ((Value >> 16) == NVIC_SIM_APINT_WRITE_KEY) {
+                NVIC_SimState.PriGroup = Value & NVIC_SIM_APINT_PRIGROUP_MASK;
+                if ((Value & NVIC_SIM_APINT_SYSRESETREQ) != 0) {
+                    NVIC_SimState.ResetRequests++;
+                }
+            }
+            break;
+        case NVIC_SYSTEM_SYSCTRL_ADDR:
+            NVIC_SimState.SysCtrl = Value & NVIC_SIM_SYSCTRL_MASK;
+            break;
+        case NVIC_SYSTEM_CFGCTRL_ADDR:
+            NVIC_SimState.CfgCtrl = Value & NVIC_SIM_CFGCTRL_MASK;
+            break;
+        case NVIC_SYSTEM_PRI1_ADDR:
+            NVIC_SimState.SysPri1 = Value & NVIC_SIM_SYSPRI1_MASK;
+            break;
+        case NVIC_SYSTEM_PRI2_ADDR:
+            NVIC_SimState.SysPri2 = Value & NVIC_SIM_SYSPRI2_MASK;
+            break;
+        case NVIC_SYSTEM_PRI3_ADDR:
+            NVIC_SimState.SysPri3 = Value & NVIC_SIM_SYSPRI3_MASK;
+            break;
+        case NVIC_SYSTEM_SYSHNDCTRL_ADDR:
+            NVIC_SimState.SysHndCtrl = Value & NVIC_SIM_SYSHNDCTRL_MASK;
+            break;
+        case NVIC_SYSTEM_FAULTSTAT_ADDR:
+            /* Write-one-to-clear status bits */
+            NVIC_SimState.FaultStat &= ~Value;
+            break;
+        case NVIC_SYSTEM_HFAULTSTAT_ADDR:
+            NVIC_SimState.HFaultStat &= ~Value;
+            break;
+        case NVIC_SYSTEM_MMADDR_ADDR:
+            NVIC_SimState.MmAddr = Value;
+            break;
+        case NVIC_SYSTEM_FAULTADDR_ADDR:
+            NVIC_SimState.FaultAddr = Value;
+            break;
+        case NVIC_SYSTEM_DEMCR_ADDR:
+            NVIC_SimState.Demcr = Value;
+            break;
+        case NVIC_FPU_FPCCR_ADDR:
+            NVIC_SimState.Fpccr = Value & NVIC_SIM_FPCCR_MASK;
+            break;
+        case NVIC_DWT_CTRL_ADDR:
+            NVIC_SimState.DwtCtrl = Value;
+            break;
+        case NVIC_DWT_CYCCNT_ADDR:
+            NVIC_SimState.CycCnt = Value;
+            break;
+        default:
+            GenericReg = NVIC_Sim_GenericReg(Address);
+            if (GenericReg != NULL_PTR) {
+                GenericReg->Value = Value;
+            }
+            break;
+    }
+}
+
+/* Set/clear registers take a byte store as a word store of the shifted byte */
+static boolean NVIC_Sim_IsSetClearReg(uint32 Address)
+{
+    return ((NVIC_Sim_GroupIndex(Address, NVIC_EN0_ADDR, NVIC_IRQ_REG_COUNT) != NVIC_SIM_NO_INDEX) ||
+            (NVIC_Sim_GroupIndex(Address, NVIC_DIS0_ADDR, NVIC_IRQ_REG_COUNT) != NVIC_SIM_NO_INDEX) ||
+            (NVIC_Sim_GroupIndex(Address, NVIC_PEND0_ADDR, NVIC_IRQ_REG_COUNT) != NVIC_SIM_NO_INDEX) ||
+            (NVIC_Sim_GroupIndex(Address, NVIC_UNPEND0_ADDR, NVIC_IRQ_REG_COUNT) != NVIC_SIM_NO_INDEX));
+}
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_Reset
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to put every simulated register back to its reset
+ *              value and clear the access statistics
+ **********************************************************************/
+void NVIC_Sim_Reset(void) {
+    uint8 *StatePtr = (uint8 *)&NVIC_SimState;
+    uint32 i;
+    for (i = 0; i < sizeof(NVIC_SimState); i++) {
+        StatePtr[i] = 0;
+    }
+    NVIC_SimState.CfgCtrl = NVIC_SIM_CFGCTRL_RESET;
+    NVIC_SimState.Fpccr = NVIC_SIM_FPCCR_RESET;
+    NVIC_SimFrame = NULL_PTR;
+    NVIC_SimInitialized = TRUE;
+    NVIC_Sim_ClearStats();
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_Read32
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Address - Address of the register
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Value read from the simulated register
+ * Description: Function to perform a counted 32-bit load from a simulated register
+ **********************************************************************/
+uint32 NVIC_Sim_Read32(uint32 Address) {
+    NVIC_Sim_EnsureInitialized();
+    NVIC_SimStats.Loads++;
+    NVIC_SimStats.Cycles += NVIC_SIM_LOAD_CYCLES;
+    return NVIC_Sim_Load(Address & ~3UL);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_Write32
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Address - Address of the register
+ *                  Value - Value to store
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to perform a counted 32-bit store to a simulated register
+ *              applying the hardware write semantics of that register
+ **********************************************************************/
+void NVIC_Sim_Write32(uint32 Address, uint32 Value) {
+    NVIC_Sim_EnsureInitialized();
+    NVIC_SimStats.Stores++;
+    NVIC_SimStats.Cycles += NVIC_SIM_STORE_CYCLES;
+    NVIC_Sim_Store(Address & ~3UL, Value);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_Read8
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Address - Address of the register byte
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint8 - Value read from the simulated register byte
+ * Description: Function to perform a counted 8-bit load from a simulated register
+ **********************************************************************/
+uint8 NVIC_Sim_Read8(uint32 Address) {
+    uint32 Shift = (Address & 3UL) * 8U;
+    NVIC_Sim_EnsureInitialized();
+    NVIC_SimStats.Loads++;
+    NVIC_SimStats.Cycles += NVIC_SIM_LOAD_CYCLES;
+    return (uint8)(NVIC_Sim_Load(Address & ~3UL) >> Shift);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_Write8
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Address - Address of the register byte
+ *                  Value - Value to store
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to perform a counted 8-bit store to a simulated register
+ **********************************************************************/
+void NVIC_Sim_Write8(uint32 Address, uint8 Value) {
+    uint32 WordAddress = Address & ~3UL;
+    uint32 Shift = (Address & 3UL) * 8U;
+    uint32 Word;
+    NVIC_Sim_EnsureInitialized();
+    NVIC_SimStats.Stores++;
+    NVIC_SimStats.Cycles += NVIC_SIM_STORE_CYCLES;
+    if (NVIC_Sim_IsSetClearReg(WordAddress) == TRUE) {
+        Word = ((uint32)Value << Shift);
+    } else {
+        Word = NVIC_Sim_Load(WordAddress);
+        Word &= ~(0xFFUL << Shift);
+        Word |= ((uint32)Value << Shift);
+    }
+    NVIC_Sim_Store(WordAddress, Word);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): Stats - Copy of the access statistics
+ * Return value: None
+ * Description: Function to read the number of loads, stores and bus cycles
+ *              issued since the last reset or clear
+ **********************************************************************/
+void NVIC_Sim_GetStats(NVIC_SimStatsType *Stats) {
+    if (Stats != NULL_PTR) {
+        *Stats = NVIC_SimStats;
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_ClearStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the access statistics without touching the
+ *              simulated register contents
+ **********************************************************************/
+void NVIC_Sim_ClearStats(void) {
+    NVIC_SimStats.Loads = 0;
+    NVIC_SimStats.Stores = 0;
+    NVIC_SimStats.Cycles = 0;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_SetPrimask
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Value - New value of the simulated PRIMASK I-bit
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for CPSIE I / CPSID I
+ **********************************************************************/
+void NVIC_Sim_SetPrimask(uint32 Value) {
+    NVIC_Sim_EnsureInitialized();
+    NVIC_SimState.Primask = Value & 1UL;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetPrimask
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Value of the simulated PRIMASK I-bit
+ * Description: Function to read the simulated PRIMASK
+ **********************************************************************/
+uint32 NVIC_Sim_GetPrimask(void) {
+    NVIC_Sim_EnsureInitialized();
+    return NVIC_SimState.Primask;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_SetFaultmask
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Value - New value of the simulated FAULTMASK F-bit
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for CPSIE F / CPSID F
+ **********************************************************************/
+void NVIC_Sim_SetFaultmask(uint32 Value) {
+    NVIC_Sim_EnsureInitialized();
+    NVIC_SimState.Faultmask = Value & 1UL;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetFaultmask
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Value of the simulated FAULTMASK F-bit
+ * Description: Function to read the simulated FAULTMASK
+ **********************************************************************/
+uint32 NVIC_Sim_GetFaultmask(void) {
+    NVIC_Sim_EnsureInitialized();
+    return NVIC_SimState.Faultmask;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_SetBasepri
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Value - New value of the simulated BASEPRI
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for MSR BASEPRI
+ **********************************************************************/
+void NVIC_Sim_SetBasepri(uint32 Value) {
+    NVIC_Sim_EnsureInitialized();
+    NVIC_SimState.Basepri = Value & NVIC_SIM_BASEPRI_MASK;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_SetBasepriMax
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Value - Requested value of the simulated BASEPRI
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for MSR BASEPRI_MAX, only raises the masking level
+ **********************************************************************/
+void NVIC_Sim_SetBasepriMax(uint32 Value) {
+    NVIC_Sim_EnsureInitialized();
+    Value &= NVIC_SIM_BASEPRI_MASK;
+    if ((Value != 0) && ((NVIC_SimState.Basepri == 0) || (Value < NVIC_SimState.Basepri))) {
+        NVIC_SimState.Basepri = Value;
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetBasepri
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Value of the simulated BASEPRI
+ * Description: Host stand-in for MRS BASEPRI
+ **********************************************************************/
+uint32 NVIC_Sim_GetBasepri(void) {
+    NVIC_Sim_EnsureInitialized();
+    return NVIC_SimState.Basepri;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_AdvanceCycles
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Cycles - Number of core cycles that elapsed
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to advance the simulated DWT cycle counter, which
+ *              counts only while DEMCR.TRCENA and DWT_CTRL.CYCCNTENA are set
+ **********************************************************************/
+void NVIC_Sim_AdvanceCycles(uint32 Cycles) {
+    NVIC_Sim_EnsureInitialized();
+    if (((NVIC_SimState.Demcr & DEMCR_TRCENA_MASK) != 0) &&
+        ((NVIC_SimState.DwtCtrl & DWT_CTRL_CYCCNTENA_MASK) != 0)) {
+        NVIC_SimState.CycCnt += Cycles;
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_SetVectorTable
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Table - Vector table the simulated VTABLE points to
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for the VTABLE store. Counted like a store to VTABLE,
+ *              and keeps the full host pointer that does not fit the 32-bit register
+ **********************************************************************/
+void NVIC_Sim_SetVectorTable(NVIC_SimHandlerType *Table) {
+    NVIC_Sim_Write32(NVIC_SYSTEM_VTABLE_ADDR, (uint32)(unsigned long)Table);
+    NVIC_SimState.VectorTable = Table;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetVectorTable
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_SimHandlerType * - Vector table set with NVIC_Sim_SetVectorTable
+ * Description: Function to get the vector table the simulated VTABLE points to
+ **********************************************************************/
+NVIC_SimHandlerType *NVIC_Sim_GetVectorTable(void) {
+    NVIC_Sim_EnsureInitialized();
+    return NVIC_SimState.VectorTable;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_RaiseFault
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Fault_Status - Bits to set in FAULTSTAT (CFSR)
+ *                  HardFault_Status - Bits to set in HFAULTSTAT (HFSR)
+ *                  MemManage_Address - Value of MMADDR (MMFAR)
+ *                  Bus_Address - Value of FAULTADDR (BFAR)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to latch the fault status the hardware records when a
+ *              fault is taken, the status registers are write-one-to-clear afterwards
+ **********************************************************************/
+void NVIC_Sim_RaiseFault(uint32 Fault_Status, uint32 HardFault_Status, uint32 MemManage_Address, uint32 Bus_Address) {
+    NVIC_Sim_EnsureInitialized();
+    NVIC_SimState.FaultStat |= Fault_Status;
+    NVIC_SimState.HFaultStat |= HardFault_Status;
+    NVIC_SimState.MmAddr = MemManage_Address;
+    NVIC_SimState.FaultAddr = Bus_Address;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetResetRequests
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Number of APINT.SYSRESETREQ writes since NVIC_Sim_Reset
+ * Description: Function to observe the system resets requested by the driver
+ **********************************************************************/
+uint32 NVIC_Sim_GetResetRequests(void) {
+    NVIC_Sim_EnsureInitialized();
+    return NVIC_SimState.ResetRequests;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_TouchFpu
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for a floating-point instruction: marks the running
+ *              context as owning FP state and, inside a simulated handler, performs
+ *              a pending lazy FP state push
+ **********************************************************************/
+void NVIC_Sim_TouchFpu(void) {
+    NVIC_Sim_EnsureInitialized();
+    if (NVIC_SimFrame != NULL_PTR) {
+        if ((NVIC_SimState.Fpccr & NVIC_SIM_FPCCR_LSPACT) != 0) {
+            NVIC_SimState.Fpccr &= ~NVIC_SIM_FPCCR_LSPACT;
+            NVIC_SimFrame->Cost.FpStatePushed = TRUE;
+            NVIC_Sim_AdvanceCycles(NVIC_SIM_FP_STATE_CYCLES);
+        } else if (NVIC_SimFrame->FpUnpreserved == TRUE) {
+            /* The handler overwrites FP registers the interrupted context still owns */
+            NVIC_SimState.FpCorruptions++;
+            NVIC_SimFrame->FpUnpreserved = FALSE;
+        } else {
+            /* FP state already preserved, or the interrupted context had none */
+        }
+    }
+    NVIC_SimState.Fpca = TRUE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_TakeIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the IRQ was pending, enabled and unmasked and ran
+ * Description: Function to take a pending IRQ the way the core does: entry stacking
+ *              as selected by FPCCR and CONTROL.FPCA, the handler of the simulated
+ *              vector table, then exit unstacking. The modelled entry and exit
+ *              cycles advance the DWT cycle counter
+ **********************************************************************/
+boolean NVIC_Sim_TakeIRQ(uint32 IRQ_Num) {
+    NVIC_SimFrameType Frame;
+    NVIC_SimFrameType *Interrupted;
+    NVIC_SimHandlerType Handler = NULL_PTR;
+    boolean InterruptedFpca;
+    uint32 Word;
+    uint32 Bit;
+
+    NVIC_Sim_EnsureInitialized();
+    if (IRQ_Num >= NVIC_IRQ_COUNT) {
+        return FALSE;
+    }
+    Word = IRQ_Num >> 5;
+    Bit = 1UL << (IRQ_Num & 31UL);
+    if (((NVIC_SimState.Pending[Word] & NVIC_SimState.Enable[Word] & Bit) == 0) || (NVIC_SimState.Primask != 0)) {
+        return FALSE;
+    }
+    NVIC_Sim_Wake();
+    NVIC_SimState.Pending[Word] &= ~Bit;
+    NVIC_SimState.Active[Word] |= Bit;
+
+    /* Entry: an interrupted context owning FP state gets the extended frame when ASPEN is set */
+    InterruptedFpca = NVIC_SimState.Fpca;
+    Frame.Extended = ((InterruptedFpca == TRUE) && ((NVIC_SimState.Fpccr & NVIC_SIM_FPCCR_ASPEN) != 0)) ? TRUE : FALSE;
+    Frame.FpUnpreserved = ((InterruptedFpca == TRUE) && (Frame.Extended == FALSE)) ? TRUE : FALSE;
+    Frame.Cost.EntryCycles = NVIC_SIM_ENTRY_CYCLES;
+    Frame.Cost.ExitCycles = NVIC_SIM_EXIT_CYCLES;
+    Frame.Cost.FrameWords = NVIC_SIM_BASIC_FRAME_WORDS;
+    Frame.Cost.FpStatePushed = FALSE;
+    if (Frame.Extended == TRUE) {
+        Frame.Cost.FrameWords = NVIC_SIM_EXTENDED_FRAME_WORDS;
+        if ((NVIC_SimState.Fpccr & NVIC_SIM_FPCCR_LSPEN) != 0) {
+            /* Space reserved, the push waits for the first FP instruction of the handler */
+            NVIC_SimState.Fpccr |= NVIC_SIM_FPCCR_LSPACT;
+        } else {
+            Frame.Cost.EntryCycles += NVIC_SIM_FP_STATE_CYCLES;
+            Frame.Cost.FpStatePushed = TRUE;
+        }
+    }
+    NVIC_Sim_AdvanceCycles(Frame.Cost.EntryCycles);
+    NVIC_SimState.Fpca = FALSE;
+    Interrupted = NVIC_SimFrame;
+    NVIC_SimFrame = &Frame;
+
+    if (NVIC_SimState.VectorTable != NULL_PTR) {
+        Handler = NVIC_SimState.VectorTable[NVIC_SIM_IRQ_VECTOR_OFFSET + IRQ_Num];
+    }
+    if (Handler != NULL_PTR) {
+        Handler();
+    }
+
+    /* Exit: a push that never happened is abandoned, a completed one is popped */
+    NVIC_SimFrame = Interrupted;
+    if (Frame.Extended == TRUE) {
+        if ((NVIC_SimState.Fpccr & NVIC_SIM_FPCCR_LSPACT) != 0) {
+            NVIC_SimState.Fpccr &= ~NVIC_SIM_FPCCR_LSPACT;
+        } else {
+            Frame.Cost.ExitCycles += NVIC_SIM_FP_STATE_CYCLES;
+        }
+    }
+    NVIC_Sim_AdvanceCycles(Frame.Cost.ExitCycles);
+    NVIC_SimState.Fpca = InterruptedFpca;
+    NVIC_SimState.Active[Word] &= ~Bit;
+    NVIC_SimState.LastException = Frame.Cost;
+
+    /* Sleep-on-exit: returning to thread mode with nothing to tail-chain puts the core back to sleep */
+    if ((Interrupted == NULL_PTR) && ((NVIC_SimState.SysCtrl & NVIC_SIM_SYSCTRL_SLEEPONEXIT) != 0) &&
+        (NVIC_Sim_HighestPendingIRQ() == NVIC_SIM_NO_INDEX)) {
+        NVIC_Sim_EnterSleep();
+        NVIC_SimState.Sleep.SleepOnExits++;
+    }
+    return TRUE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetLastException
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): Cost - Modelled cost of the last IRQ run by NVIC_Sim_TakeIRQ
+ * Return value: None
+ * Description: Function to read the entry/exit cycles and frame size of the last
+ *              simulated exception
+ **********************************************************************/
+void NVIC_Sim_GetLastException(NVIC_SimExceptionCostType *Cost) {
+    NVIC_Sim_EnsureInitialized();
+    if (Cost != NULL_PTR) {
+        *Cost = NVIC_SimState.LastException;
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetFpCorruptions
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Number of handlers that used the FPU over an unpreserved FP context
+ * Description: Function to detect handlers that would corrupt the interrupted FP
+ *              state, which happens when ASPEN is clear
+ **********************************************************************/
+uint32 NVIC_Sim_GetFpCorruptions(void) {
+    NVIC_Sim_EnsureInitialized();
+    return NVIC_SimState.FpCorruptions;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_WaitForInterrupt
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for WFI: the core goes to sleep (deep sleep when
+ *              SLEEPDEEP is set) and the highest priority pending IRQ, which stands
+ *              for the event arriving during the sleep, wakes it and is taken. With
+ *              nothing pending the core stays asleep until the next NVIC_Sim_TakeIRQ
+ **********************************************************************/
+void NVIC_Sim_WaitForInterrupt(void) {
+    NVIC_Sim_EnsureInitialized();
+    NVIC_Sim_EnterSleep();
+    NVIC_Sim_WakeOnPending();
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_WaitForEvent
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for WFE: a set event register (SEV, or an IRQ that
+ *              became pending under SEVONPEND) is cleared without sleeping,
+ *              otherwise the core sleeps like NVIC_Sim_WaitForInterrupt
+ **********************************************************************/
+void NVIC_Sim_WaitForEvent(void) {
+    NVIC_Sim_EnsureInitialized();
+    if (NVIC_SimState.EventRegister == TRUE) {
+        NVIC_SimState.EventRegister = FALSE;
+        return;
+    }
+    NVIC_Sim_EnterSleep();
+    NVIC_Sim_WakeOnPending();
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_SendEvent
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for SEV, sets the event register
+ **********************************************************************/
+void NVIC_Sim_SendEvent(void) {
+    NVIC_Sim_EnsureInitialized();
+    NVIC_SimState.EventRegister = TRUE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetSleepStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): Stats - Sleep entries and wake-ups since NVIC_Sim_Reset
+ * Return value: None
+ * Description: Function to observe how often the simulated core slept
+ **********************************************************************/
+void NVIC_Sim_GetSleepStats(NVIC_SimSleepStatsType *Stats) {
+    NVIC_Sim_EnsureInitialized();
+    if (Stats != NULL_PTR) {
+        *Stats = NVIC_SimState.Sleep;
+    }
+}
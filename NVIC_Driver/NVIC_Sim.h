@@ -0,0 +1,437 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Sim.h
+ *
+ * Description: Header file for the host-side NVIC/SCB register simulator.
+ *              Only used when the driver is built with NVIC_HOST_SIM defined.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_SIM_H_
+#define NVIC_SIM_H_
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+/* Bus cycles charged for each simulated load/store on the private peripheral bus */
+#ifndef NVIC_SIM_LOAD_CYCLES
+#define NVIC_SIM_LOAD_CYCLES                 2U
+#endif
+
+#ifndef NVIC_SIM_STORE_CYCLES
+#define NVIC_SIM_STORE_CYCLES                1U
+#endif
+
+/* Exception entry/exit cost model of the Cortex-M4 with zero wait-state stack memory:
+ * 8-word basic frame, 26-word extended frame of which S0-S15 and FPSCR (17 words)
+ * are stored at one cycle per word, either at entry or on the first FP instruction.
+ * Tools/NVIC_Analyze.c budgets exceptions with the same figures */
+#define NVIC_SIM_ENTRY_CYCLES                12U
+#define NVIC_SIM_EXIT_CYCLES                 10U
+#define NVIC_SIM_FP_STATE_CYCLES             17U
+#define NVIC_SIM_BASIC_FRAME_WORDS           8U
+#define NVIC_SIM_EXTENDED_FRAME_WORDS        26U
+
+/*******************************************************************************
+ * DATA TYPES DDECLERATIONS                                                    *
+ *******************************************************************************/
+typedef void (*NVIC_SimHandlerType)(void);
+
+typedef struct
+{
+    uint32 Loads;       /* Number of register loads issued by the driver  */
+    uint32 Stores;      /* Number of register stores issued by the driver */
+    uint32 Cycles;      /* Bus cycles charged for the loads and stores    */
+} NVIC_SimStatsType;
+
+/* Modelled cost of one exception taken by NVIC_Sim_TakeIRQ */
+typedef struct
+{
+    uint32 EntryCycles;     /* Stacking cycles at entry, the lazy push is charged when it happens */
+    uint32 ExitCycles;      /* Unstacking cycles at exit                                         */
+    uint32 FrameWords;      /* Stack words of the exception frame (8 basic, 26 extended)         */
+    boolean FpStatePushed;  /* S0-S15/FPSCR were stored, at entry or lazily                      */
+} NVIC_SimExceptionCostType;
+
+/* Sleep entries of the simulated core */
+typedef struct
+{
+    uint32 Sleeps;          /* WFI/WFE sleeps and sleep-on-exit returns      */
+    uint32 DeepSleeps;      /* Sleeps entered with SLEEPDEEP set             */
+    uint32 SleepOnExits;    /* Sleeps entered on return to thread mode       */
+    uint32 Wakes;           /* Wake-ups by a pending IRQ                     */
+} NVIC_SimSleepStatsType;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES                                                         *
+ *******************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_Reset
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to put every simulated register back to its reset
+ *              value and clear the access statistics
+ **********************************************************************/
+void NVIC_Sim_Reset(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_Read32
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Address - Address of the register
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Value read from the simulated register
+ * Description: Function to perform a counted 32-bit load from a simulated register
+ **********************************************************************/
+uint32 NVIC_Sim_Read32(uint32 Address);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_Write32
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Address - Address of the register
+ *                  Value - Value to store
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to perform a counted 32-bit store to a simulated register
+ *              applying the hardware write semantics of that register
+ **********************************************************************/
+void NVIC_Sim_Write32(uint32 Address, uint32 Value);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_Read8
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Address - Address of the register byte
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint8 - Value read from the simulated register byte
+ * Description: Function to perform a counted 8-bit load from a simulated register
+ **********************************************************************/
+uint8 NVIC_Sim_Read8(uint32 Address);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_Write8
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Address - Address of the register byte
+ *                  Value - Value to store
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to perform a counted 8-bit store to a simulated register
+ **********************************************************************/
+void NVIC_Sim_Write8(uint32 Address, uint8 Value);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): Stats - Copy of the access statistics
+ * Return value: None
+ * Description: Function to read the number of loads, stores and bus cycles
+ *              issued since the last reset or clear
+ **********************************************************************/
+void NVIC_Sim_GetStats(NVIC_SimStatsType *Stats);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_ClearStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the access statistics without touching the
+ *              simulated register contents
+ **********************************************************************/
+void NVIC_Sim_ClearStats(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_SetPrimask
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Value - New value of the simulated PRIMASK I-bit
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for CPSIE I / CPSID I
+ **********************************************************************/
+void NVIC_Sim_SetPrimask(uint32 Value);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetPrimask
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Value of the simulated PRIMASK I-bit
+ * Description: Function to read the simulated PRIMASK
+ **********************************************************************/
+uint32 NVIC_Sim_GetPrimask(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_SetFaultmask
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Value - New value of the simulated FAULTMASK F-bit
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for CPSIE F / CPSID F
+ **********************************************************************/
+void NVIC_Sim_SetFaultmask(uint32 Value);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetFaultmask
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Value of the simulated FAULTMASK F-bit
+ * Description: Function to read the simulated FAULTMASK
+ **********************************************************************/
+uint32 NVIC_Sim_GetFaultmask(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_SetBasepri
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Value - New value of the simulated BASEPRI
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for MSR BASEPRI
+ **********************************************************************/
+void NVIC_Sim_SetBasepri(uint32 Value);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_SetBasepriMax
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Value - Requested value of the simulated BASEPRI
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for MSR BASEPRI_MAX, only raises the masking level
+ **********************************************************************/
+void NVIC_Sim_SetBasepriMax(uint32 Value);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetBasepri
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Value of the simulated BASEPRI
+ * Description: Host stand-in for MRS BASEPRI
+ **********************************************************************/
+uint32 NVIC_Sim_GetBasepri(void);
+/*********************************************************************
+ * Service Name: NVIC_Sim_AdvanceCycles
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Cycles - Number of core cycles that elapsed
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to advance the simulated DWT cycle counter, which
+ *              counts only while DEMCR.TRCENA and DWT_CTRL.CYCCNTENA are set
+ **********************************************************************/
+void NVIC_Sim_AdvanceCycles(uint32 Cycles);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_SetVectorTable
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Table - Vector table the simulated VTABLE points to
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for the VTABLE store. Counted like a store to VTABLE,
+ *              and keeps the full host pointer that does not fit the 32-bit register
+ **********************************************************************/
+void NVIC_Sim_SetVectorTable(NVIC_SimHandlerType *Table);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetVectorTable
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_SimHandlerType * - Vector table set with NVIC_Sim_SetVectorTable
+ * Description: Function to get the vector table the simulated VTABLE points to
+ **********************************************************************/
+NVIC_SimHandlerType *NVIC_Sim_GetVectorTable(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_RaiseFault
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Fault_Status - Bits to set in FAULTSTAT (CFSR)
+ *                  HardFault_Status - Bits to set in HFAULTSTAT (HFSR)
+ *                  MemManage_Address - Value of MMADDR (MMFAR)
+ *                  Bus_Address - Value of FAULTADDR (BFAR)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to latch the fault status the hardware records when a
+ *              fault is taken, the status registers are write-one-to-clear afterwards
+ **********************************************************************/
+void NVIC_Sim_RaiseFault(uint32 Fault_Status, uint32 HardFault_Status, uint32 MemManage_Address, uint32 Bus_Address);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetResetRequests
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Number of APINT.SYSRESETREQ writes since NVIC_Sim_Reset
+ * Description: Function to observe the system resets requested by the driver
+ **********************************************************************/
+uint32 NVIC_Sim_GetResetRequests(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_TouchFpu
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for a floating-point instruction: marks the running
+ *              context as owning FP state and, inside a simulated handler, performs
+ *              a pending lazy FP state push
+ **********************************************************************/
+void NVIC_Sim_TouchFpu(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_TakeIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the IRQ was pending, enabled and unmasked and ran
+ * Description: Function to take a pending IRQ the way the core does: entry stacking
+ *              as selected by FPCCR and CONTROL.FPCA, the handler of the simulated
+ *              vector table, then exit unstacking. The modelled entry and exit
+ *              cycles advance the DWT cycle counter
+ **********************************************************************/
+boolean NVIC_Sim_TakeIRQ(uint32 IRQ_Num);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetLastException
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): Cost - Modelled cost of the last IRQ run by NVIC_Sim_TakeIRQ
+ * Return value: None
+ * Description: Function to read the entry/exit cycles and frame size of the last
+ *              simulated exception
+ **********************************************************************/
+void NVIC_Sim_GetLastException(NVIC_SimExceptionCostType *Cost);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetFpCorruptions
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Number of handlers that used the FPU over an unpreserved FP context
+ * Description: Function to detect handlers that would corrupt the interrupted FP
+ *              state, which happens when ASPEN is clear
+ **********************************************************************/
+uint32 NVIC_Sim_GetFpCorruptions(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_WaitForInterrupt
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for WFI: the core goes to sleep (deep sleep when
+ *              SLEEPDEEP is set) and the highest priority pending IRQ, which stands
+ *              for the event arriving during the sleep, wakes it and is taken. With
+ *              nothing pending the core stays asleep until the next NVIC_Sim_TakeIRQ
+ **********************************************************************/
+void NVIC_Sim_WaitForInterrupt(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_WaitForEvent
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for WFE: a set event register (SEV, or an IRQ that
+ *              became pending under SEVONPEND) is cleared without sleeping,
+ *              otherwise the core sleeps like NVIC_Sim_WaitForInterrupt
+ **********************************************************************/
+void NVIC_Sim_WaitForEvent(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_SendEvent
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Host stand-in for SEV, sets the event register
+ **********************************************************************/
+void NVIC_Sim_SendEvent(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Sim_GetSleepStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): Stats - Sleep entries and wake-ups since NVIC_Sim_Reset
+ * Return value: None
+ * Description: Function to observe how often the simulated core slept
+ **********************************************************************/
+void NVIC_Sim_GetSleepStats(NVIC_SimSleepStatsType *Stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_SIM_H_ */
@@ -0,0 +1,349 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Sleep.c
+ *
+ * Description: Source file for the sleep control of the ARM Cortex M4 NVIC driver.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+
+#include "NVIC_Sleep.h"
+#include "NVIC_Regs.h"
+#include "NVIC_Seqlock.h"
+
+#if NVIC_SLEEP_STATS_ENABLE
+
+/*******************************************************************************
+ * DATA TYPES DDECLERATIONS                                                    *
+ *******************************************************************************/
+
+/* A record is written by the handler of its own IRQ, which cannot preempt itself,
+ * and by NVIC_Sleep_ClaimPending in thread mode under PRIMASK, so no handler
+ * writes it in between. Readers copy it under its sequence counter */
+typedef struct
+{
+    volatile uint32 Sequence;
+    NVIC_SleepWakeRecordType Record;
+} NVIC_SleepWakeEntryType;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+static NVIC_SleepWakeEntryType NVIC_SleepWakeEntries[NVIC_IRQ_COUNT];
+
+/* CYCCNT when the core last went to sleep, and 1 until the first handler claims the wake-up */
+static volatile uint32 NVIC_SleepStamp;
+static volatile uint32 NVIC_SleepArmed;
+
+#endif /* NVIC_SLEEP_STATS_ENABLE */
+
+/*******************************************************************************
+ * PRIVATE FUNCTION DEFINITIONS                                                *
+ *******************************************************************************/
+
+/* SYSCTRL is also written from handlers clearing SLEEPONEXIT, the read-modify-write
+ * runs under PRIMASK */
+static void NVIC_Sleep_WriteControl(uint32 Mask, boolean Enable) {
+    uint32 Saved;
+    NVIC_ENTER_CRITICAL(Saved);
+    if (Enable == TRUE) {
+        NVIC_WRITE32(NVIC_SYSTEM_SYSCTRL_ADDR, NVIC_READ32(NVIC_SYSTEM_SYSCTRL_ADDR) | Mask);
+    } else {
+        NVIC_WRITE32(NVIC_SYSTEM_SYSCTRL_ADDR, NVIC_READ32(NVIC_SYSTEM_SYSCTRL_ADDR) & ~Mask);
+    }
+    NVIC_EXIT_CRITICAL(Saved);
+}
+
+#if NVIC_SLEEP_STATS_ENABLE
+
+/* Add one wake-up latency to the record of IRQ_Num */
+static void NVIC_Sleep_Account(uint32 IRQ_Num, uint32 Latency) {
+    NVIC_SleepWakeEntryType *Entry = &NVIC_SleepWakeEntries[IRQ_Num];
+    NVIC_Seqlock_WriteBegin(&Entry->Sequence);
+    Entry->Record.Wakes++;
+    Entry->Record.TotalLatency += Latency;
+    if (Latency < Entry->Record.MinLatency) {
+        Entry->Record.MinLatency = Latency;
+    }
+    if (Latency > Entry->Record.MaxLatency) {
+        Entry->Record.MaxLatency = Latency;
+    }
+    NVIC_Seqlock_WriteEnd(&Entry->Sequence);
+}
+
+/* Right after WFI/WFE: a wake-up no handler has claimed yet (PRIMASK set, the
+ * handler runs only once it is cleared) goes to the IRQ named by INTCTRL.VECPEND,
+ * the latency ends at the thread resuming. Wake-ups by an event or a system
+ * exception are dropped */
+static void NVIC_Sleep_ClaimPending(void) {
+    uint32 WakeStamp = NVIC_DWT_NOW();
+    uint32 Vector = (NVIC_READ32(NVIC_SYSTEM_INTCTRL_ADDR) & INTCTRL_VECPEND_MASK) >> INTCTRL_VECPEND_BITS_POS;
+    uint32 Saved;
+
+    do {
+        if (NVIC_ATOMIC_LOAD(&NVIC_SleepArmed) == 0U) {
+            return;
+        }
+    } while (NVIC_ATOMIC_CAS(&NVIC_SleepArmed, 1U, 0U) == FALSE);
+    if ((Vector >= NVIC_IRQ_VECTOR_OFFSET) && ((Vector - NVIC_IRQ_VECTOR_OFFSET) < NVIC_IRQ_COUNT)) {
+        /* The IRQ may be unmasked: its handler, after a sleep-on-exit, would account
+         * into the same record */
+        NVIC_ENTER_CRITICAL(Saved);
+        NVIC_Sleep_Account(Vector - NVIC_IRQ_VECTOR_OFFSET, WakeStamp - NVIC_SleepStamp);
+        NVIC_EXIT_CRITICAL(Saved);
+    }
+}
+
+#endif /* NVIC_SLEEP_STATS_ENABLE */
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to program the sleep controls of NVIC_Cfg.h and, when
+ *              compiled in, start the DWT cycle counter and clear the wake records
+ **********************************************************************/
+void NVIC_Sleep_Init(void) {
+#if NVIC_SLEEP_STATS_ENABLE
+    uint32 IRQ_Num;
+    for (IRQ_Num = 0; IRQ_Num < NVIC_IRQ_COUNT; IRQ_Num++) {
+        NVIC_Sleep_ClearWakeRecord((NVIC_IRQType)IRQ_Num);
+    }
+    NVIC_ATOMIC_STORE(&NVIC_SleepArmed, 0U);
+    NVIC_DWT_Start();
+#endif
+    NVIC_Sleep_SetDeep(NVIC_SLEEP_DEEP);
+    NVIC_Sleep_SetEventOnPend(NVIC_SLEEP_EVENT_ON_PEND);
+    NVIC_Sleep_SetOnExit(NVIC_SLEEP_ON_EXIT);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_SetOnExit
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Enable - TRUE to sleep again on every return to thread mode
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set or clear SYSCTRL.SLEEPONEXIT. A handler clears it
+ *              to let the thread run again after it returns
+ **********************************************************************/
+void NVIC_Sleep_SetOnExit(boolean Enable) {
+    NVIC_Sleep_WriteControl(SYSCTRL_SLEEPONEXIT_MASK, Enable);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_SetDeep
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Enable - TRUE to make the next sleep a deep sleep
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set or clear SYSCTRL.SLEEPDEEP
+ **********************************************************************/
+void NVIC_Sleep_SetDeep(boolean Enable) {
+    NVIC_Sleep_WriteControl(SYSCTRL_SLEEPDEEP_MASK, Enable);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_SetEventOnPend
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Enable - TRUE to make an IRQ becoming pending a WFE wake-up event
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set or clear SYSCTRL.SEVONPEND. Disabled IRQs count as
+ *              well, so a thread can wait with WFE for a source it polls itself
+ **********************************************************************/
+void NVIC_Sleep_SetEventOnPend(boolean Enable) {
+    NVIC_Sleep_WriteControl(SYSCTRL_SEVONPEND_MASK, Enable);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_IdleUntilInterrupt
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to sleep (WFI) until an IRQ is pending. Under sleep-on-exit
+ *              it only returns once a handler has cleared SLEEPONEXIT. To check for
+ *              work without losing a wake-up, call it with Disable_Exceptions()
+ *              after finding nothing to do: the core still wakes on the pending IRQ
+ *              and its handler runs at Enable_Exceptions()
+ **********************************************************************/
+void NVIC_IdleUntilInterrupt(void) {
+#if NVIC_SLEEP_STATS_ENABLE
+    NVIC_SleepStamp = NVIC_DWT_NOW();
+    NVIC_ATOMIC_STORE(&NVIC_SleepArmed, 1U);
+#endif
+    /* Outstanding stores (SYSCTRL included) complete before the core sleeps */
+    NVIC_DSB();
+    NVIC_WFI();
+#if NVIC_SLEEP_STATS_ENABLE
+    NVIC_Sleep_ClaimPending();
+#endif
+    NVIC_ISB();
+}
+
+/*********************************************************************
+ * Service Name: NVIC_IdleUntilEvent
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to sleep (WFE) until an event: an IRQ able to preempt,
+ *              any IRQ becoming pending under SEVONPEND, or NVIC_Sleep_SignalEvent.
+ *              Returns at once, clearing it, if an event arrived since the last call
+ **********************************************************************/
+void NVIC_IdleUntilEvent(void) {
+#if NVIC_SLEEP_STATS_ENABLE
+    NVIC_SleepStamp = NVIC_DWT_NOW();
+    NVIC_ATOMIC_STORE(&NVIC_SleepArmed, 1U);
+#endif
+    NVIC_DSB();
+    NVIC_WFE();
+#if NVIC_SLEEP_STATS_ENABLE
+    NVIC_Sleep_ClaimPending();
+#endif
+    NVIC_ISB();
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_SignalEvent
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set the event register (SEV), so a thread that found
+ *              no work just before NVIC_IdleUntilEvent does not miss it
+ **********************************************************************/
+void NVIC_Sleep_SignalEvent(void) {
+    NVIC_DSB();
+    NVIC_SEV();
+}
+
+#if NVIC_SLEEP_STATS_ENABLE
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_WakeEntry
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ being serviced
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to account a wake-up if the core was asleep when IRQ_Num
+ *              was taken. Called first thing in the handler (NVIC_SLEEP_ISR)
+ **********************************************************************/
+void NVIC_Sleep_WakeEntry(NVIC_IRQType IRQ_Num) {
+    uint32 EntryStamp = NVIC_DWT_NOW();
+
+    if ((uint32)IRQ_Num >= NVIC_IRQ_COUNT) {
+        return;
+    }
+    /* Only the first handler after the sleep claims the wake-up, a higher priority
+     * one preempting it before the claim takes it over */
+    do {
+        if (NVIC_ATOMIC_LOAD(&NVIC_SleepArmed) == 0U) {
+            return;
+        }
+    } while (NVIC_ATOMIC_CAS(&NVIC_SleepArmed, 1U, 0U) == FALSE);
+    NVIC_Sleep_Account((uint32)IRQ_Num, EntryStamp - NVIC_SleepStamp);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_WakeExit
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to stamp the sleep a handler is about to return into under
+ *              sleep-on-exit. Called last thing in the handler (NVIC_SLEEP_ISR)
+ **********************************************************************/
+void NVIC_Sleep_WakeExit(void) {
+    uint32 IntCtrl;
+    if ((NVIC_READ32(NVIC_SYSTEM_SYSCTRL_ADDR) & SYSCTRL_SLEEPONEXIT_MASK) == 0) {
+        return;
+    }
+    /* The core only sleeps when returning to thread mode with nothing to tail-chain */
+    IntCtrl = NVIC_READ32(NVIC_SYSTEM_INTCTRL_ADDR);
+    if (((IntCtrl & INTCTRL_RETBASE_MASK) == 0) || ((IntCtrl & INTCTRL_VECPEND_MASK) != 0)) {
+        return;
+    }
+    NVIC_SleepStamp = NVIC_DWT_NOW();
+    NVIC_ATOMIC_STORE(&NVIC_SleepArmed, 1U);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_GetWakeRecord
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): Record - Consistent copy of the IRQ wake record
+ * Return value: boolean - TRUE if a consistent copy was taken, FALSE if the
+ *               record kept changing
+ * Description: Function to read the wake-up latencies of an IRQ while the system keeps running
+ **********************************************************************/
+boolean NVIC_Sleep_GetWakeRecord(NVIC_IRQType IRQ_Num, NVIC_SleepWakeRecordType *Record) {
+    const NVIC_SleepWakeEntryType *Entry;
+
+    if (((uint32)IRQ_Num >= NVIC_IRQ_COUNT) || (Record == NULL_PTR)) {
+        return FALSE;
+    }
+    Entry = &NVIC_SleepWakeEntries[IRQ_Num];
+    return NVIC_Seqlock_Read(&Entry->Sequence, &Entry->Record, Record, sizeof(*Record),
+                             NVIC_SLEEP_SNAPSHOT_RETRIES);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_ClearWakeRecord
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the wake record of an IRQ
+ **********************************************************************/
+void NVIC_Sleep_ClearWakeRecord(NVIC_IRQType IRQ_Num) {
+    NVIC_SleepWakeEntryType *Entry;
+    if ((uint32)IRQ_Num >= NVIC_IRQ_COUNT) {
+        return;
+    }
+    Entry = &NVIC_SleepWakeEntries[IRQ_Num];
+    NVIC_Seqlock_WriteBegin(&Entry->Sequence);
+    Entry->Record.Wakes = 0;
+    Entry->Record.TotalLatency = 0;
+    Entry->Record.MinLatency = 0xFFFFFFFFUL;
+    Entry->Record.MaxLatency = 0;
+    NVIC_Seqlock_WriteEnd(&Entry->Sequence);
+}
+
+#endif /* NVIC_SLEEP_STATS_ENABLE */
@@ -0,0 +1,236 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Sleep.h
+ *
+ * Description: Header file for the sleep control of the ARM Cortex M4 NVIC driver.
+ *              Drives the SYSCTRL sleep bits and the WFI/WFE idle primitives, so an
+ *              application can run purely from interrupts: with sleep-on-exit the
+ *              core goes back to sleep straight from handler exit. Optionally records
+ *              the wake-up latency of each IRQ that wakes the core.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_SLEEP_H_
+#define NVIC_SLEEP_H_
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+#include "std_types.h"
+#include "NVIC.h"
+#include "NVIC_Cfg.h"
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+#define SYSCTRL_SLEEPONEXIT_MASK             0x00000002
+#define SYSCTRL_SLEEPDEEP_MASK               0x00000004
+#define SYSCTRL_SEVONPEND_MASK               0x00000010
+
+/* INTCTRL.RETBASE: no exception active besides the running one */
+#define INTCTRL_RETBASE_MASK                 0x00000800
+/* INTCTRL.VECPEND: highest priority pending exception, 0 if none */
+#define INTCTRL_VECPEND_MASK                 0x001FF000
+#define INTCTRL_VECPEND_BITS_POS             12U
+
+/* Wake-record snapshot retries before giving up when the record keeps being updated */
+#define NVIC_SLEEP_SNAPSHOT_RETRIES          4U
+
+/* Defines the ISR Isr_Name that runs Handler for IRQ_Num and accounts the wake-ups
+ * it causes when the wake-up latency records are compiled in, directly otherwise */
+#if NVIC_SLEEP_STATS_ENABLE
+#define NVIC_SLEEP_ISR(Isr_Name, IRQ_Num, Handler) \
+    void Isr_Name(void) { NVIC_Sleep_WakeEntry((IRQ_Num)); Handler(); NVIC_Sleep_WakeExit(); }
+#else
+#define NVIC_SLEEP_ISR(Isr_Name, IRQ_Num, Handler) \
+    void Isr_Name(void) { Handler(); }
+#endif
+
+/*******************************************************************************
+ * DATA TYPES DDECLERATIONS                                                    *
+ *******************************************************************************/
+
+/* Wake-ups caused by one IRQ. The latency runs from the sleep stamp to the first
+ * instruction of the handler in core cycles: CYCCNT stops while the core clock is
+ * gated, so the sleep itself is not counted (it is when a debugger keeps the clock
+ * running). After a sleep-on-exit it also includes the exception return. When the
+ * core sleeps with PRIMASK set it ends at the thread resuming from WFI/WFE instead,
+ * charged to the IRQ pending at that point (INTCTRL.VECPEND) */
+typedef struct
+{
+    uint32 Wakes;           /* Number of times the IRQ woke the core           */
+    uint64 TotalLatency;    /* Sum of the wake-up latencies in cycles          */
+    uint32 MinLatency;      /* Shortest wake-up latency, 0xFFFFFFFF if no wake */
+    uint32 MaxLatency;      /* Longest wake-up latency                         */
+} NVIC_SleepWakeRecordType;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES                                                         *
+ *******************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to program the sleep controls of NVIC_Cfg.h and, when
+ *              compiled in, start the DWT cycle counter and clear the wake records
+ **********************************************************************/
+void NVIC_Sleep_Init(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_SetOnExit
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Enable - TRUE to sleep again on every return to thread mode
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set or clear SYSCTRL.SLEEPONEXIT. A handler clears it
+ *              to let the thread run again after it returns
+ **********************************************************************/
+void NVIC_Sleep_SetOnExit(boolean Enable);
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_SetDeep
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Enable - TRUE to make the next sleep a deep sleep
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set or clear SYSCTRL.SLEEPDEEP
+ **********************************************************************/
+void NVIC_Sleep_SetDeep(boolean Enable);
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_SetEventOnPend
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Enable - TRUE to make an IRQ becoming pending a WFE wake-up event
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set or clear SYSCTRL.SEVONPEND. Disabled IRQs count as
+ *              well, so a thread can wait with WFE for a source it polls itself
+ **********************************************************************/
+void NVIC_Sleep_SetEventOnPend(boolean Enable);
+
+/*********************************************************************
+ * Service Name: NVIC_IdleUntilInterrupt
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to sleep (WFI) until an IRQ is pending. Under sleep-on-exit
+ *              it only returns once a handler has cleared SLEEPONEXIT. To check for
+ *              work without losing a wake-up, call it with Disable_Exceptions()
+ *              after finding nothing to do: the core still wakes on the pending IRQ
+ *              and its handler runs at Enable_Exceptions()
+ **********************************************************************/
+void NVIC_IdleUntilInterrupt(void);
+
+/*********************************************************************
+ * Service Name: NVIC_IdleUntilEvent
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to sleep (WFE) until an event: an IRQ able to preempt,
+ *              any IRQ becoming pending under SEVONPEND, or NVIC_Sleep_SignalEvent.
+ *              Returns at once, clearing it, if an event arrived since the last call
+ **********************************************************************/
+void NVIC_IdleUntilEvent(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_SignalEvent
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set the event register (SEV), so a thread that found
+ *              no work just before NVIC_IdleUntilEvent does not miss it
+ **********************************************************************/
+void NVIC_Sleep_SignalEvent(void);
+
+#if NVIC_SLEEP_STATS_ENABLE
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_WakeEntry
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ being serviced
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to account a wake-up if the core was asleep when IRQ_Num
+ *              was taken. Called first thing in the handler (NVIC_SLEEP_ISR)
+ **********************************************************************/
+void NVIC_Sleep_WakeEntry(NVIC_IRQType IRQ_Num);
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_WakeExit
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to stamp the sleep a handler is about to return into under
+ *              sleep-on-exit. Called last thing in the handler (NVIC_SLEEP_ISR)
+ **********************************************************************/
+void NVIC_Sleep_WakeExit(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_GetWakeRecord
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): Record - Consistent copy of the IRQ wake record
+ * Return value: boolean - TRUE if a consistent copy was taken, FALSE if the
+ *               record kept changing
+ * Description: Function to read the wake-up latencies of an IRQ while the system keeps running
+ **********************************************************************/
+boolean NVIC_Sleep_GetWakeRecord(NVIC_IRQType IRQ_Num, NVIC_SleepWakeRecordType *Record);
+
+/*********************************************************************
+ * Service Name: NVIC_Sleep_ClearWakeRecord
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the wake record of an IRQ
+ **********************************************************************/
+void NVIC_Sleep_ClearWakeRecord(NVIC_IRQType IRQ_Num);
+
+#endif /* NVIC_SLEEP_STATS_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_SLEEP_H_ */
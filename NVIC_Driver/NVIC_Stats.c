@@ -0,0 +1,181 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Stats.c
+ *
+ * Description: Source file for the optional per-IRQ instrumentation of the ARM Cortex M4
+ *              NVIC driver.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+
+#include "NVIC_Stats.h"
+#include "NVIC_Regs.h"
+#include "NVIC_Seqlock.h"
+
+#if NVIC_STATS_ENABLE
+
+/*******************************************************************************
+ * DATA TYPES DDECLERATIONS                                                    *
+ *******************************************************************************/
+
+/* A record is only written by the handler of its own IRQ, which cannot preempt
+ * itself, and cleared from thread mode. Readers copy it under its sequence counter */
+typedef struct
+{
+    volatile uint32 Sequence;
+    NVIC_StatsRecordType Record;
+} NVIC_StatsEntryType;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+static NVIC_StatsEntryType NVIC_StatsEntries[NVIC_IRQ_COUNT];
+static volatile uint32 NVIC_StatsTriggerStamp[NVIC_IRQ_COUNT];
+static volatile uint8 NVIC_StatsTriggerMarked[NVIC_IRQ_COUNT];
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+/*********************************************************************
+ * Service Name: NVIC_Stats_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to start the DWT cycle counter and clear all the records
+ **********************************************************************/
+void NVIC_Stats_Init(void) {
+    uint32 IRQ_Num;
+    for (IRQ_Num = 0; IRQ_Num < NVIC_IRQ_COUNT; IRQ_Num++) {
+        NVIC_Stats_Clear((NVIC_IRQType)IRQ_Num);
+    }
+    NVIC_WRITE32(NVIC_DWT_CYCCNT_ADDR, 0);
+    NVIC_DWT_Start();
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Stats_MarkTrigger
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ that is about to become pending
+ *                  Trigger_Stamp - NVIC_STATS_NOW() value at the time of the trigger
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to record when an IRQ was triggered, so the next entry
+ *              of its handler also measures the entry latency
+ **********************************************************************/
+void NVIC_Stats_MarkTrigger(NVIC_IRQType IRQ_Num, uint32 Trigger_Stamp) {
+    if ((uint32)IRQ_Num >= NVIC_IRQ_COUNT) {
+        return;
+    }
+    NVIC_StatsTriggerStamp[IRQ_Num] = Trigger_Stamp;
+    NVIC_COMPILER_BARRIER();
+    NVIC_StatsTriggerMarked[IRQ_Num] = TRUE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Stats_Dispatch
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ being serviced
+ *                  Handler - Handler of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to run an IRQ handler and account its entry count,
+ *              run time and entry latency. Called from the ISR itself
+ **********************************************************************/
+void NVIC_Stats_Dispatch(NVIC_IRQType IRQ_Num, NVIC_StatsHandlerType Handler) {
+    uint32 EntryStamp = NVIC_STATS_NOW();
+    uint32 Latency = 0;
+    boolean LatencyValid = FALSE;
+    uint32 RunCycles;
+    NVIC_StatsEntryType *Entry;
+
+    if ((uint32)IRQ_Num >= NVIC_IRQ_COUNT) {
+        Handler();
+        return;
+    }
+    if (NVIC_StatsTriggerMarked[IRQ_Num] == TRUE) {
+        Latency = EntryStamp - NVIC_StatsTriggerStamp[IRQ_Num];
+        NVIC_StatsTriggerMarked[IRQ_Num] = FALSE;
+        LatencyValid = TRUE;
+    }
+
+    Handler();
+
+    RunCycles = NVIC_STATS_NOW() - EntryStamp;
+
+    Entry = &NVIC_StatsEntries[IRQ_Num];
+    NVIC_Seqlock_WriteBegin(&Entry->Sequence);
+    Entry->Record.Entries++;
+    Entry->Record.TotalCycles += RunCycles;
+    if (RunCycles > Entry->Record.MaxCycles) {
+        Entry->Record.MaxCycles = RunCycles;
+    }
+    if ((LatencyValid == TRUE) && (Latency > Entry->Record.MaxLatency)) {
+        Entry->Record.MaxLatency = Latency;
+    }
+    NVIC_Seqlock_WriteEnd(&Entry->Sequence);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Stats_GetSnapshot
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): Snapshot - Consistent copy of the IRQ record
+ * Return value: boolean - TRUE if a consistent copy was taken, FALSE if the
+ *               record kept changing (e.g. read from an ISR that preempted its handler)
+ * Description: Function to read the statistics of an IRQ while the system keeps running
+ **********************************************************************/
+boolean NVIC_Stats_GetSnapshot(NVIC_IRQType IRQ_Num, NVIC_StatsRecordType *Snapshot) {
+    const NVIC_StatsEntryType *Entry;
+
+    if (((uint32)IRQ_Num >= NVIC_IRQ_COUNT) || (Snapshot == NULL_PTR)) {
+        return FALSE;
+    }
+    Entry = &NVIC_StatsEntries[IRQ_Num];
+    return NVIC_Seqlock_Read(&Entry->Sequence, &Entry->Record, Snapshot, sizeof(*Snapshot),
+                             NVIC_STATS_SNAPSHOT_RETRIES);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Stats_Clear
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the statistics of an IRQ
+ **********************************************************************/
+void NVIC_Stats_Clear(NVIC_IRQType IRQ_Num) {
+    NVIC_StatsEntryType *Entry;
+    if ((uint32)IRQ_Num >= NVIC_IRQ_COUNT) {
+        return;
+    }
+    Entry = &NVIC_StatsEntries[IRQ_Num];
+    NVIC_Seqlock_WriteBegin(&Entry->Sequence);
+    Entry->Record.Entries = 0;
+    Entry->Record.TotalCycles = 0;
+    Entry->Record.MaxCycles = 0;
+    Entry->Record.MaxLatency = 0;
+    NVIC_Seqlock_WriteEnd(&Entry->Sequence);
+    NVIC_StatsTriggerMarked[IRQ_Num] = FALSE;
+}
+
+#endif /* NVIC_STATS_ENABLE */
@@ -0,0 +1,143 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Stats.h
+ *
+ * Description: Header file for the optional per-IRQ instrumentation of the ARM Cortex M4
+ *              NVIC driver. Each instrumented ISR runs its handler through a thin
+ *              dispatch wrapper that timestamps it with the DWT cycle counter.
+ *              Compiled in with NVIC_STATS_ENABLE set to 1 in NVIC_Cfg.h.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_STATS_H_
+#define NVIC_STATS_H_
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+#include "std_types.h"
+#include "NVIC.h"
+#include "NVIC_Cfg.h"
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+/* Snapshot retries before giving up when the record keeps being updated */
+#define NVIC_STATS_SNAPSHOT_RETRIES          4U
+
+/* Current value of the DWT cycle counter */
+#define NVIC_STATS_NOW()                     NVIC_DWT_NOW()
+
+/* Defines the ISR Isr_Name that runs Handler for IRQ_Num, through the statistics
+ * dispatch wrapper when the instrumentation is compiled in, directly otherwise */
+#if NVIC_STATS_ENABLE
+#define NVIC_STATS_ISR(Isr_Name, IRQ_Num, Handler) \
+    void Isr_Name(void) { NVIC_Stats_Dispatch((IRQ_Num), (Handler)); }
+#else
+#define NVIC_STATS_ISR(Isr_Name, IRQ_Num, Handler) \
+    void Isr_Name(void) { Handler(); }
+#endif
+
+/*******************************************************************************
+ * DATA TYPES DDECLERATIONS                                                    *
+ *******************************************************************************/
+typedef void (*NVIC_StatsHandlerType)(void);
+
+typedef struct
+{
+    uint32 Entries;         /* Number of times the handler ran                          */
+    uint64 TotalCycles;     /* Sum of the handler run times in cycles                   */
+    uint32 MaxCycles;       /* Longest handler run time in cycles                       */
+    uint32 MaxLatency;      /* Longest trigger-to-entry time of the marked triggers     */
+} NVIC_StatsRecordType;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES                                                         *
+ *******************************************************************************/
+#if NVIC_STATS_ENABLE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************************************************************
+ * Service Name: NVIC_Stats_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to start the DWT cycle counter and clear all the records
+ **********************************************************************/
+void NVIC_Stats_Init(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Stats_MarkTrigger
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ that is about to become pending
+ *                  Trigger_Stamp - NVIC_STATS_NOW() value at the time of the trigger
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to record when an IRQ was triggered, so the next entry
+ *              of its handler also measures the entry latency
+ **********************************************************************/
+void NVIC_Stats_MarkTrigger(NVIC_IRQType IRQ_Num, uint32 Trigger_Stamp);
+
+/*********************************************************************
+ * Service Name: NVIC_Stats_Dispatch
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ being serviced
+ *                  Handler - Handler of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to run an IRQ handler and account its entry count,
+ *              run time and entry latency. Called from the ISR itself
+ **********************************************************************/
+void NVIC_Stats_Dispatch(NVIC_IRQType IRQ_Num, NVIC_StatsHandlerType Handler);
+
+/*********************************************************************
+ * Service Name: NVIC_Stats_GetSnapshot
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): Snapshot - Consistent copy of the IRQ record
+ * Return value: boolean - TRUE if a consistent copy was taken, FALSE if the
+ *               record kept changing (e.g. read from an ISR that preempted its handler)
+ * Description: Function to read the statistics of an IRQ while the system keeps running
+ **********************************************************************/
+boolean NVIC_Stats_GetSnapshot(NVIC_IRQType IRQ_Num, NVIC_StatsRecordType *Snapshot);
+
+/*********************************************************************
+ * Service Name: NVIC_Stats_Clear
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the statistics of an IRQ
+ **********************************************************************/
+void NVIC_Stats_Clear(NVIC_IRQType IRQ_Num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NVIC_STATS_ENABLE */
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_STATS_H_ */
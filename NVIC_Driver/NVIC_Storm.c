@@ -0,0 +1,216 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Storm.c
+ *
+ * Description: Source file for the interrupt storm limiter of the ARM Cortex M4
+ *              NVIC driver.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+
+#include "NVIC_Storm.h"
+#include "NVIC_Regs.h"
+
+#if NVIC_STORM_ENABLE
+
+/* Every NVIC_CFG_STORM_TABLE entry is checked at build time */
+#define NVIC_STORM_CHECK(IRQ_Num, Budget, Backoff_Ticks) \
+    typedef char NVIC_StormCheck_##IRQ_Num[(NVIC_IRQ_IS_VALID(IRQ_Num) && ((Budget) > 0U) && ((Backoff_Ticks) > 0U)) ? 1 : -1];
+
+NVIC_CFG_STORM_TABLE(NVIC_STORM_CHECK)
+
+typedef char NVIC_StormTableCheck[((NVIC_STORM_SLOT_COUNT > 0) && (NVIC_STORM_SLOT_COUNT < 0xFF) && (NVIC_STORM_WINDOW_TICKS > 0U)) ? 1 : -1];
+
+/*******************************************************************************
+ * DATA TYPES DDECLERATIONS                                                    *
+ *******************************************************************************/
+
+typedef struct
+{
+    uint8 IRQ_Num;
+    uint32 Budget;
+    uint32 BackoffTicks;
+} NVIC_StormConfigType;
+
+/* Count is only incremented by the ISR of its own IRQ and cleared by the tick, an
+ * increment racing with the window reset is carried into the next window */
+typedef struct
+{
+    volatile uint32 Count;              /* Entries in the current window          */
+    volatile uint32 BackoffLeft;        /* Ticks left before re-enable, 0 if idle */
+    volatile uint32 ThrottleCount;      /* Times the IRQ was throttled            */
+    NVIC_MaskTokenType Token;           /* Mask scope held during the back-off    */
+} NVIC_StormStateType;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+#define NVIC_STORM_CONFIG(IRQ_Num, Budget, Backoff_Ticks)   { (uint8)(IRQ_Num), (Budget), (Backoff_Ticks) },
+static const NVIC_StormConfigType NVIC_StormConfig[NVIC_STORM_SLOT_COUNT] = {
+    NVIC_CFG_STORM_TABLE(NVIC_STORM_CONFIG)
+};
+
+/* Slot of each IRQ plus one, 0 for the IRQs that are not rate-limited */
+#define NVIC_STORM_LOOKUP(IRQ_Num, Budget, Backoff_Ticks)   [(IRQ_Num)] = (uint8)(NVIC_STORM_SLOT_##IRQ_Num + 1),
+static const uint8 NVIC_StormSlotOf[NVIC_IRQ_COUNT] = {
+    NVIC_CFG_STORM_TABLE(NVIC_STORM_LOOKUP)
+};
+
+static NVIC_StormStateType NVIC_StormState[NVIC_STORM_SLOT_COUNT];
+static uint32 NVIC_StormWindowTicks;
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+/* Single-IRQ set for NVIC_MaskSet: the throttle is a mask scope held for the back-off.
+ * Unlike NVIC_EnableIRQ/NVIC_DisableIRQ, NVIC_MaskSet/NVIC_UnmaskSet store ENn/DISn
+ * right away and keep the shadow in step, even while the thread holds an
+ * NVIC_BeginUpdate open, so a throttle is never held back by a pending commit */
+static void NVIC_Storm_BuildMask(NVIC_IRQMaskType *IRQ_Mask, uint32 IRQ_Num) {
+    uint32 RegIndex;
+    for (RegIndex = 0; RegIndex < NVIC_IRQ_REG_COUNT; RegIndex++) {
+        IRQ_Mask->Words[RegIndex] = 0;
+    }
+    NVIC_IRQ_MASK_ADD(*IRQ_Mask, IRQ_Num);
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Storm_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the entry counts, back-offs and throttle counters.
+ *              A back-off in progress ends and closes its mask scope
+ **********************************************************************/
+void NVIC_Storm_Init(void) {
+    uint32 Slot;
+    for (Slot = 0; Slot < NVIC_STORM_SLOT_COUNT; Slot++) {
+        if (NVIC_StormState[Slot].BackoffLeft != 0) {
+            NVIC_UnmaskSet(&NVIC_StormState[Slot].Token);
+        }
+        NVIC_StormState[Slot].Count = 0;
+        NVIC_StormState[Slot].BackoffLeft = 0;
+        NVIC_StormState[Slot].ThrottleCount = 0;
+    }
+    NVIC_StormWindowTicks = 0;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Storm_Entry
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ being serviced
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if this entry went over the budget and the IRQ was disabled
+ * Description: Function to count an entry of a rate-limited IRQ, called from its
+ *              own ISR. IRQs missing from NVIC_CFG_STORM_TABLE cost one table lookup
+ **********************************************************************/
+boolean NVIC_Storm_Entry(NVIC_IRQType IRQ_Num) {
+    uint32 Slot;
+    NVIC_StormStateType *State;
+    NVIC_IRQMaskType IRQ_Mask;
+
+    if (((uint32)IRQ_Num >= NVIC_IRQ_COUNT) || (NVIC_StormSlotOf[IRQ_Num] == 0)) {
+        return FALSE;
+    }
+    Slot = (uint32)NVIC_StormSlotOf[IRQ_Num] - 1U;
+    State = &NVIC_StormState[Slot];
+    State->Count++;
+    if ((State->Count <= NVIC_StormConfig[Slot].Budget) || (State->BackoffLeft != 0)) {
+        return FALSE;
+    }
+    NVIC_Storm_BuildMask(&IRQ_Mask, (uint32)IRQ_Num);
+    State->Token = NVIC_MaskSet(&IRQ_Mask);
+    State->ThrottleCount++;
+    State->BackoffLeft = NVIC_StormConfig[Slot].BackoffTicks;
+    return TRUE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Storm_Tick
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to advance the counting window and the back-offs, called
+ *              from the SysTick handler. When its back-off expires, a throttled IRQ
+ *              closes its NVIC_MaskSet scope: it comes back unless another scope
+ *              opened meanwhile still masks it, whose close then re-enables it
+ **********************************************************************/
+void NVIC_Storm_Tick(void) {
+    uint32 Slot;
+    boolean WindowEnd;
+    NVIC_StormStateType *State;
+
+    NVIC_StormWindowTicks++;
+    WindowEnd = (NVIC_StormWindowTicks >= NVIC_STORM_WINDOW_TICKS) ? TRUE : FALSE;
+    if (WindowEnd == TRUE) {
+        NVIC_StormWindowTicks = 0;
+    }
+    for (Slot = 0; Slot < NVIC_STORM_SLOT_COUNT; Slot++) {
+        State = &NVIC_StormState[Slot];
+        if (State->BackoffLeft != 0) {
+            State->BackoffLeft--;
+            if (State->BackoffLeft == 0) {
+                /* Fresh window for the source coming back */
+                State->Count = 0;
+                NVIC_UnmaskSet(&State->Token);
+            }
+        } else if (WindowEnd == TRUE) {
+            State->Count = 0;
+        } else {
+            /* Keep counting in the current window */
+        }
+    }
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Storm_IsThrottled
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE while the IRQ is disabled by the limiter
+ * Description: Function to check whether an IRQ is in its back-off period
+ **********************************************************************/
+boolean NVIC_Storm_IsThrottled(NVIC_IRQType IRQ_Num) {
+    if (((uint32)IRQ_Num >= NVIC_IRQ_COUNT) || (NVIC_StormSlotOf[IRQ_Num] == 0)) {
+        return FALSE;
+    }
+    return (NVIC_StormState[NVIC_StormSlotOf[IRQ_Num] - 1U].BackoffLeft != 0) ? TRUE : FALSE;
+}
+
+/*********************************************************************
+ * Service Name: NVIC_Storm_GetThrottleCount
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Number of times the IRQ was throttled since NVIC_Storm_Init
+ * Description: Function to get the throttle counter of a rate-limited IRQ
+ **********************************************************************/
+uint32 NVIC_Storm_GetThrottleCount(NVIC_IRQType IRQ_Num) {
+    if (((uint32)IRQ_Num >= NVIC_IRQ_COUNT) || (NVIC_StormSlotOf[IRQ_Num] == 0)) {
+        return 0;
+    }
+    return NVIC_StormState[NVIC_StormSlotOf[IRQ_Num] - 1U].ThrottleCount;
+}
+
+#endif /* NVIC_STORM_ENABLE */
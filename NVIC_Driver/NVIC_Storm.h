@@ -0,0 +1,134 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Storm.h
+ *
+ * Description: Header file for the interrupt storm limiter of the ARM Cortex M4 NVIC
+ *              driver. Each IRQ listed in NVIC_CFG_STORM_TABLE counts its entries per
+ *              window; a source over its budget is disabled and re-enabled after a
+ *              back-off driven by SysTick. Compiled in with NVIC_STORM_ENABLE set to 1
+ *              in NVIC_Cfg.h.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_STORM_H_
+#define NVIC_STORM_H_
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+#include "std_types.h"
+#include "NVIC.h"
+#include "NVIC_Cfg.h"
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+/* To be placed first in the ISR of a rate-limited IRQ, evaluates to TRUE when this
+ * entry throttled the IRQ. Always FALSE when the limiter is compiled out */
+#if NVIC_STORM_ENABLE
+#define NVIC_STORM_ENTRY(IRQ_Num)            NVIC_Storm_Entry((IRQ_Num))
+#else
+#define NVIC_STORM_ENTRY(IRQ_Num)            (FALSE)
+#endif
+
+/*******************************************************************************
+ * DATA TYPES DDECLERATIONS                                                    *
+ *******************************************************************************/
+
+/* Rate-limited IRQs, one slot per NVIC_CFG_STORM_TABLE entry */
+#define NVIC_STORM_SLOT_ENUM(IRQ_Num, Budget, Backoff_Ticks)    NVIC_STORM_SLOT_##IRQ_Num,
+typedef enum {
+    NVIC_CFG_STORM_TABLE(NVIC_STORM_SLOT_ENUM)
+    NVIC_STORM_SLOT_COUNT
+} NVIC_StormSlotType;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES                                                         *
+ *******************************************************************************/
+#if NVIC_STORM_ENABLE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************************************************************
+ * Service Name: NVIC_Storm_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the entry counts, back-offs and throttle counters.
+ *              A back-off in progress ends and closes its mask scope
+ **********************************************************************/
+void NVIC_Storm_Init(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Storm_Entry
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ being serviced
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if this entry went over the budget and the IRQ was disabled
+ * Description: Function to count an entry of a rate-limited IRQ, called from its
+ *              own ISR. IRQs missing from NVIC_CFG_STORM_TABLE cost one table lookup
+ **********************************************************************/
+boolean NVIC_Storm_Entry(NVIC_IRQType IRQ_Num);
+
+/*********************************************************************
+ * Service Name: NVIC_Storm_Tick
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to advance the counting window and the back-offs, called
+ *              from the SysTick handler. When its back-off expires, a throttled IRQ
+ *              closes its NVIC_MaskSet scope: it comes back unless another scope
+ *              opened meanwhile still masks it, whose close then re-enables it
+ **********************************************************************/
+void NVIC_Storm_Tick(void);
+
+/*********************************************************************
+ * Service Name: NVIC_Storm_IsThrottled
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE while the IRQ is disabled by the limiter
+ * Description: Function to check whether an IRQ is in its back-off period
+ **********************************************************************/
+boolean NVIC_Storm_IsThrottled(NVIC_IRQType IRQ_Num);
+
+/*********************************************************************
+ * Service Name: NVIC_Storm_GetThrottleCount
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Number of times the IRQ was throttled since NVIC_Storm_Init
+ * Description: Function to get the throttle counter of a rate-limited IRQ
+ **********************************************************************/
+uint32 NVIC_Storm_GetThrottleCount(NVIC_IRQType IRQ_Num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NVIC_STORM_ENABLE */
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_STORM_H_ */
@@ -0,0 +1,235 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Deferred_Test.c
+ *
+ * Description: Host stress test of the deferred work ring. Producer threads stand
+ *              in for ISRs of different priorities and post concurrently through
+ *              the host NVIC_ATOMIC_CAS while one thread drains, as PendSV would.
+ *              Checks that no work item is lost or run twice, that each producer's
+ *              items run in posting order and that every rejected post is counted
+ *              in Dropped.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <sched.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "NVIC_Test.h"
+
+/* The ring is compiled in here so its atomics yield at random points */
+static void Test_PreemptPoint(void);
+#define NVIC_HOST_PREEMPT_POINT()            Test_PreemptPoint()
+#include "NVIC_Deferred.c"
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+#define TEST_PRODUCERS                       4U
+#define TEST_ITEMS_PER_PRODUCER              200000U
+
+/* One atomic access in TEST_PREEMPT_ODDS yields the processor */
+#define TEST_PREEMPT_ODDS                    16U
+
+/* Rejected posts in a row after which a producer reports the ring stuck full */
+#define TEST_MAX_RETRIES                     50000U
+
+/* A corrupted ring can also leave a producer spinning inside the push */
+#define TEST_TIMEOUT_SECONDS                 30U
+
+/* Work item context: producer number in the top byte, its post number below */
+#define TEST_CONTEXT(Producer, Item)         ((void *)(uintptr_t)(((uint32)(Producer) << 24) | (uint32)(Item)))
+#define TEST_PRODUCER_OF(Context)            ((uint32)((uintptr_t)(Context) >> 24))
+#define TEST_ITEM_OF(Context)                ((uint32)((uintptr_t)(Context) & 0x00FFFFFFUL))
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+static NVIC_DeferredQueueType Test_Queue;
+
+/* Written by the drainer only */
+static uint8 Test_RunCount[TEST_PRODUCERS][TEST_ITEMS_PER_PRODUCER];
+static uint32 Test_NextItem[TEST_PRODUCERS];
+static uint32 Test_OutOfOrder;
+static uint32 Test_BadContext;
+
+/* Posts each producer saw rejected, and how many producers are still posting */
+static uint32 Test_Rejected[TEST_PRODUCERS];
+static boolean Test_Stuck[TEST_PRODUCERS];
+static volatile uint32 Test_ProducersLeft;
+
+/* Per-thread xorshift state of the preemption points */
+static __thread uint32 Test_PreemptSeed;
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+static void Test_PreemptPoint(void) {
+    uint32 Seed = Test_PreemptSeed;
+    if (Seed == 0U) {
+        Seed = (uint32)(uintptr_t)&Test_PreemptSeed | 1U;
+    }
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 17;
+    Seed ^= Seed << 5;
+    Test_PreemptSeed = Seed;
+    if ((Seed % TEST_PREEMPT_ODDS) == 0U) {
+        sched_yield();
+    }
+}
+
+static void Test_Work(void *Context) {
+    uint32 Producer = TEST_PRODUCER_OF(Context);
+    uint32 Item = TEST_ITEM_OF(Context);
+
+    if ((Producer >= TEST_PRODUCERS) || (Item >= TEST_ITEMS_PER_PRODUCER)) {
+        Test_BadContext++;
+        return;
+    }
+    if (Item < Test_NextItem[Producer]) {
+        Test_OutOfOrder++;
+    }
+    Test_NextItem[Producer] = Item + 1U;
+    if (Test_RunCount[Producer][Item] < 0xFFU) {
+        Test_RunCount[Producer][Item]++;
+    }
+}
+
+/* Posts every item once, retrying the rejected ones until the drainer makes room */
+static void *Test_Producer(void *Argument) {
+    uint32 Producer = (uint32)(uintptr_t)Argument;
+    uint32 Item;
+    uint32 Retries;
+
+    for (Item = 0; (Item < TEST_ITEMS_PER_PRODUCER) && (Test_Stuck[Producer] == FALSE); Item++) {
+        Retries = 0;
+        while (NVIC_DeferredQueue_Push(&Test_Queue, Test_Work, TEST_CONTEXT(Producer, Item)) == FALSE) {
+            Test_Rejected[Producer]++;
+            if (++Retries == TEST_MAX_RETRIES) {
+                Test_Stuck[Producer] = TRUE;
+                break;
+            }
+            sched_yield();
+        }
+    }
+    (void)__atomic_sub_fetch(&Test_ProducersLeft, 1U, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void *Test_Drainer(void *Argument) {
+    (void)Argument;
+    while (NVIC_ATOMIC_LOAD(&Test_ProducersLeft) != 0U) {
+        if (NVIC_DeferredQueue_Drain(&Test_Queue, NVIC_DEFERRED_BATCH_SIZE) == 0U) {
+            sched_yield();
+        }
+    }
+    while (NVIC_DeferredQueue_Drain(&Test_Queue, NVIC_DEFERRED_BATCH_SIZE) != 0U) {
+    }
+    return NULL;
+}
+
+/* N producers and one drainer running at once */
+static void Test_ConcurrentPosting(void) {
+    pthread_t Producers[TEST_PRODUCERS];
+    pthread_t Drainer;
+    uint32 Producer;
+    uint32 Item;
+    uint32 Missing = 0;
+    uint32 Duplicated = 0;
+    uint32 Rejected = 0;
+
+    NVIC_DeferredQueue_Init(&Test_Queue);
+    Test_ProducersLeft = TEST_PRODUCERS;
+    TEST_CHECK(pthread_create(&Drainer, NULL, Test_Drainer, NULL) == 0);
+    for (Producer = 0; Producer < TEST_PRODUCERS; Producer++) {
+        TEST_CHECK(pthread_create(&Producers[Producer], NULL, Test_Producer, (void *)(uintptr_t)Producer) == 0);
+    }
+    for (Producer = 0; Producer < TEST_PRODUCERS; Producer++) {
+        (void)pthread_join(Producers[Producer], NULL);
+        Rejected += Test_Rejected[Producer];
+        TEST_CHECK(Test_Stuck[Producer] == FALSE);
+    }
+    (void)pthread_join(Drainer, NULL);
+
+    for (Producer = 0; Producer < TEST_PRODUCERS; Producer++) {
+        for (Item = 0; Item < TEST_ITEMS_PER_PRODUCER; Item++) {
+            if (Test_RunCount[Producer][Item] == 0U) {
+                Missing++;
+            } else if (Test_RunCount[Producer][Item] > 1U) {
+                Duplicated++;
+            } else {
+                /* Run exactly once */
+            }
+        }
+    }
+    printf("concurrent: %u producers x %u items, %u posts rejected while full\n",
+           (unsigned)TEST_PRODUCERS, (unsigned)TEST_ITEMS_PER_PRODUCER, (unsigned)Rejected);
+    TEST_CHECK(Missing == 0U);
+    TEST_CHECK(Duplicated == 0U);
+    TEST_CHECK(Test_OutOfOrder == 0U);
+    TEST_CHECK(Test_BadContext == 0U);
+    TEST_CHECK(Test_Queue.Dropped == Rejected);
+    TEST_CHECK(NVIC_DeferredQueue_IsEmpty(&Test_Queue) == TRUE);
+}
+
+static uint32 Test_SequentialRuns;
+static uint32 Test_SequentialLast;
+
+static void Test_SequentialWork(void *Context) {
+    Test_SequentialLast = TEST_ITEM_OF(Context);
+    Test_SequentialRuns++;
+}
+
+/* Filling the ring: exactly NVIC_DEFERRED_QUEUE_SIZE posts fit, the rest are dropped and counted */
+static void Test_FullRing(void) {
+    uint32 Item;
+    uint32 Accepted = 0;
+
+    NVIC_DeferredQueue_Init(&Test_Queue);
+    for (Item = 0; Item < NVIC_DEFERRED_QUEUE_SIZE + 5U; Item++) {
+        if (NVIC_DeferredQueue_Push(&Test_Queue, Test_SequentialWork, TEST_CONTEXT(0U, Item)) == TRUE) {
+            Accepted++;
+        }
+    }
+    TEST_CHECK(Accepted == NVIC_DEFERRED_QUEUE_SIZE);
+    TEST_CHECK(Test_Queue.Dropped == 5U);
+    TEST_CHECK(NVIC_DeferredQueue_Push(&Test_Queue, NULL_PTR, NULL_PTR) == FALSE);
+    TEST_CHECK(Test_Queue.Dropped == 5U);
+
+    TEST_CHECK(NVIC_DeferredQueue_Drain(&Test_Queue, 3U) == 3U);
+    TEST_CHECK(Test_SequentialLast == 2U);
+    TEST_CHECK(NVIC_DeferredQueue_Push(&Test_Queue, Test_SequentialWork, TEST_CONTEXT(0U, 1000U)) == TRUE);
+    TEST_CHECK(NVIC_DeferredQueue_Drain(&Test_Queue, 0xFFFFFFFFUL) == NVIC_DEFERRED_QUEUE_SIZE - 2U);
+    TEST_CHECK(Test_SequentialLast == 1000U);
+    TEST_CHECK(Test_SequentialRuns == NVIC_DEFERRED_QUEUE_SIZE + 1U);
+    TEST_CHECK(NVIC_DeferredQueue_IsEmpty(&Test_Queue) == TRUE);
+}
+
+static void Test_Timeout(int Signal) {
+    static const char Message[] = "FAIL: timed out, the ring livelocked\n";
+    (void)Signal;
+    (void)write(STDOUT_FILENO, Message, sizeof(Message) - 1U);
+    _exit(1);
+}
+
+int main(void) {
+    (void)signal(SIGALRM, Test_Timeout);
+    (void)alarm(TEST_TIMEOUT_SECONDS);
+    Test_FullRing();
+    Test_ConcurrentPosting();
+    return TEST_REPORT();
+}
@@ -0,0 +1,297 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Fault_Test.c
+ *
+ * Description: Host test of the fault capture against the simulator registers.
+ *              Calls NVIC_Fault_Capture the way the naked handlers would and checks
+ *              the records kept in the ring, the sequence validation of a slot torn
+ *              by a reset, the reset/recover decision, a fault on stacking and the
+ *              report built by NVIC_Fault_Format.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+
+#include <string.h>
+
+#include "NVIC_Test.h"
+
+/* The capture is compiled in here so the test can tear a ring slot */
+#include "NVIC.h"
+#include "NVIC_Sim.h"
+#include "NVIC_Fault.c"
+
+#if !NVIC_FAULT_ENABLE
+#error "NVIC_Fault_Test.c needs NVIC_FAULT_ENABLE set to 1"
+#endif
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+/* EXC_RETURN of a fault taken from thread mode on the process stack */
+#define TEST_EXC_RETURN_PSP                  0xFFFFFFFDUL
+
+#define TEST_PC                              0x00001234UL
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+/* Action the hook returns, and the PC it stores in the frame when not zero */
+static NVIC_FaultActionType Test_HookAction;
+static uint32 Test_HookResumePC;
+static uint32 Test_HookRuns;
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+static NVIC_FaultActionType Test_Hook(const NVIC_FaultRecordType *Record, uint32 *Frame) {
+    (void)Record;
+    if (Test_HookResumePC != 0U) {
+        Frame[NVIC_FAULT_FRAME_PC] = Test_HookResumePC;
+    }
+    Test_HookRuns++;
+    return Test_HookAction;
+}
+
+static void Test_Setup(void) {
+    NVIC_Sim_Reset();
+    NVIC_Fault_SetHook(NULL_PTR);
+    NVIC_Fault_Clear();
+    Test_HookAction = NVIC_FAULT_ACTION_RESET;
+    Test_HookResumePC = 0;
+    Test_HookRuns = 0;
+}
+
+/* A stacked frame whose words tell the fault number */
+static void Test_FillFrame(uint32 *Frame, uint32 Tag) {
+    uint32 Index;
+    for (Index = 0; Index < NVIC_FAULT_FRAME_WORDS; Index++) {
+        Frame[Index] = (Tag << 8) | Index;
+    }
+    Frame[NVIC_FAULT_FRAME_PC] = TEST_PC + Tag;
+}
+
+/* One bus fault at the given address, as the Bus Fault handler would record it */
+static void Test_BusFault(uint32 Tag) {
+    uint32 Frame[NVIC_FAULT_FRAME_WORDS];
+    Test_FillFrame(Frame, Tag);
+    NVIC_Sim_RaiseFault(FAULTSTAT_PRECISE_MASK | FAULTSTAT_BFARV_MASK, 0, 0, 0x40000000UL + Tag);
+    NVIC_Fault_Capture(Frame, TEST_EXC_RETURN_PSP, EXCEPTION_BUS_FAULT_TYPE);
+    /* The status the reset would clear */
+    NVIC_WRITE32(NVIC_SYSTEM_FAULTSTAT_ADDR, 0xFFFFFFFFUL);
+}
+
+/* The record of a capture, and the reset the default action requests */
+static void Test_Capture(void) {
+    NVIC_FaultRecordType Record;
+    uint32 Frame[NVIC_FAULT_FRAME_WORDS];
+    uint32 Index;
+
+    Test_Setup();
+    TEST_CHECK(NVIC_Fault_GetCount() == 0U);
+    TEST_CHECK(NVIC_Fault_GetRecord(0, &Record) == FALSE);
+
+    Test_FillFrame(Frame, 1U);
+    NVIC_Sim_RaiseFault(FAULTSTAT_PRECISE_MASK | FAULTSTAT_BFARV_MASK, HFAULTSTAT_FORCED_MASK, 0, 0x40001000UL);
+    NVIC_Fault_Capture(Frame, TEST_EXC_RETURN_PSP, EXCEPTION_HARD_FAULT_TYPE);
+
+    TEST_CHECK(NVIC_Sim_GetResetRequests() == 1U);
+    TEST_CHECK(NVIC_Fault_GetCount() == 1U);
+    TEST_CHECK(NVIC_Fault_GetRecord(0, &Record) == TRUE);
+    TEST_CHECK(Record.Sequence == 1U);
+    TEST_CHECK(Record.Kind == EXCEPTION_HARD_FAULT_TYPE);
+    for (Index = 0; Index < NVIC_FAULT_FRAME_WORDS; Index++) {
+        TEST_CHECK(Record.Frame[Index] == Frame[Index]);
+    }
+    TEST_CHECK(Record.ExcReturn == TEST_EXC_RETURN_PSP);
+    TEST_CHECK(Record.FaultStat == (FAULTSTAT_PRECISE_MASK | FAULTSTAT_BFARV_MASK));
+    TEST_CHECK(Record.HFaultStat == HFAULTSTAT_FORCED_MASK);
+    TEST_CHECK(Record.FaultAddr == 0x40001000UL);
+    TEST_CHECK(NVIC_Fault_GetRecord(1, &Record) == FALSE);
+    TEST_CHECK(NVIC_Fault_GetRecord(0, NULL_PTR) == FALSE);
+}
+
+/* The ring keeps the last NVIC_FAULT_RING_SIZE records, a torn slot and a ring
+ * that was never formatted are refused */
+static void Test_Ring(void) {
+    NVIC_FaultRecordType Record;
+    uint32 Total = NVIC_FAULT_RING_SIZE + 3U;
+    uint32 Tag;
+    uint32 Age;
+
+    Test_Setup();
+    for (Tag = 1; Tag <= Total; Tag++) {
+        Test_BusFault(Tag);
+    }
+    TEST_CHECK(NVIC_Fault_GetCount() == Total);
+    for (Age = 0; Age < NVIC_FAULT_RING_SIZE; Age++) {
+        TEST_CHECK(NVIC_Fault_GetRecord(Age, &Record) == TRUE);
+        TEST_CHECK(Record.Sequence == Total - Age);
+        TEST_CHECK(Record.Frame[NVIC_FAULT_FRAME_PC] == TEST_PC + Total - Age);
+        TEST_CHECK(Record.FaultAddr == 0x40000000UL + Total - Age);
+    }
+    TEST_CHECK(NVIC_Fault_GetRecord(NVIC_FAULT_RING_SIZE, &Record) == FALSE);
+
+    /* A reset in the middle of the capture of fault Total - 1 */
+    NVIC_FaultRing.Records[(Total - 2U) & (NVIC_FAULT_RING_SIZE - 1U)].Sequence = 0;
+    TEST_CHECK(NVIC_Fault_GetRecord(1, &Record) == FALSE);
+    TEST_CHECK(NVIC_Fault_GetRecord(0, &Record) == TRUE);
+    TEST_CHECK(NVIC_Fault_GetRecord(2, &Record) == TRUE);
+    TEST_CHECK(Record.Sequence == Total - 2U);
+
+    /* A slot left over from an older lap of the ring */
+    NVIC_FaultRing.Records[(Total - 3U) & (NVIC_FAULT_RING_SIZE - 1U)].Sequence = Total - 3U - NVIC_FAULT_RING_SIZE;
+    TEST_CHECK(NVIC_Fault_GetRecord(2, &Record) == FALSE);
+
+    /* Init keeps a formatted ring across the reset */
+    NVIC_Fault_Init();
+    TEST_CHECK(NVIC_Fault_GetCount() == Total);
+
+    /* Power-on garbage is formatted by Init, and reads as empty before */
+    NVIC_FaultRing.Magic = 0x12345678UL;
+    TEST_CHECK(NVIC_Fault_GetCount() == 0U);
+    TEST_CHECK(NVIC_Fault_GetRecord(0, &Record) == FALSE);
+    NVIC_Fault_Init();
+    TEST_CHECK(NVIC_Fault_GetCount() == 0U);
+
+    /* And by the first capture when the fault comes before Init */
+    NVIC_FaultRing.Magic = 0;
+    NVIC_FaultRing.Count = 0x55U;
+    Test_BusFault(1U);
+    TEST_CHECK(NVIC_Fault_GetCount() == 1U);
+    TEST_CHECK(NVIC_Fault_GetRecord(0, &Record) == TRUE);
+    TEST_CHECK(Record.Sequence == 1U);
+}
+
+/* The hook decides, but a recover that would re-run the faulting instruction resets */
+static void Test_Recover(void) {
+    uint32 Frame[NVIC_FAULT_FRAME_WORDS];
+
+    Test_Setup();
+    NVIC_Fault_SetHook(Test_Hook);
+    Test_HookAction = NVIC_FAULT_ACTION_RECOVER;
+
+    /* Precise fault, PC left on the faulting instruction */
+    Test_FillFrame(Frame, 1U);
+    NVIC_Sim_RaiseFault(FAULTSTAT_UNDEF_MASK, 0, 0, 0);
+    NVIC_Fault_Capture(Frame, TEST_EXC_RETURN_PSP, EXCEPTION_USAGE_FAULT_TYPE);
+    TEST_CHECK(Test_HookRuns == 1U);
+    TEST_CHECK(NVIC_Sim_GetResetRequests() == 1U);
+    NVIC_WRITE32(NVIC_SYSTEM_FAULTSTAT_ADDR, 0xFFFFFFFFUL);
+
+    /* The hook moves the PC past it: the status is cleared and the handler returns */
+    Test_HookResumePC = TEST_PC + 0x100U;
+    NVIC_Sim_RaiseFault(FAULTSTAT_UNDEF_MASK, 0, 0, 0);
+    NVIC_Fault_Capture(Frame, TEST_EXC_RETURN_PSP, EXCEPTION_USAGE_FAULT_TYPE);
+    TEST_CHECK(NVIC_Sim_GetResetRequests() == 1U);
+    TEST_CHECK(Frame[NVIC_FAULT_FRAME_PC] == TEST_PC + 0x100U);
+    TEST_CHECK(NVIC_READ32(NVIC_SYSTEM_FAULTSTAT_ADDR) == 0U);
+
+    /* An imprecise bus fault alone resumes without the hook moving the PC */
+    Test_HookResumePC = 0;
+    NVIC_Sim_RaiseFault(FAULTSTAT_IMPRE_MASK, 0, 0, 0);
+    NVIC_Fault_Capture(Frame, TEST_EXC_RETURN_PSP, EXCEPTION_BUS_FAULT_TYPE);
+    TEST_CHECK(NVIC_Sim_GetResetRequests() == 1U);
+    TEST_CHECK(NVIC_Fault_GetCount() == 3U);
+}
+
+/* A fault on stacking never reads the frame and always resets */
+static void Test_Stacking(void) {
+    NVIC_FaultRecordType Record;
+    uint32 Index;
+
+    Test_Setup();
+    NVIC_Fault_SetHook(Test_Hook);
+    Test_HookAction = NVIC_FAULT_ACTION_RECOVER;
+    Test_HookResumePC = TEST_PC + 0x100U;
+
+    /* The frame pointer is past the end of the stack: any read of it crashes the test */
+    NVIC_Sim_RaiseFault(FAULTSTAT_MSTKE_MASK, HFAULTSTAT_FORCED_MASK, 0, 0);
+    NVIC_Fault_Capture(NULL_PTR, TEST_EXC_RETURN_PSP, EXCEPTION_HARD_FAULT_TYPE);
+    TEST_CHECK(Test_HookRuns == 1U);
+    TEST_CHECK(NVIC_Sim_GetResetRequests() == 1U);
+    TEST_CHECK(NVIC_Fault_GetRecord(0, &Record) == TRUE);
+    for (Index = 0; Index < NVIC_FAULT_FRAME_WORDS; Index++) {
+        TEST_CHECK(Record.Frame[Index] == 0U);
+    }
+    NVIC_WRITE32(NVIC_SYSTEM_FAULTSTAT_ADDR, 0xFFFFFFFFUL);
+
+    NVIC_Sim_RaiseFault(FAULTSTAT_BSTKE_MASK, 0, 0, 0);
+    NVIC_Fault_Capture(NULL_PTR, TEST_EXC_RETURN_PSP, EXCEPTION_BUS_FAULT_TYPE);
+    TEST_CHECK(NVIC_Sim_GetResetRequests() == 2U);
+    TEST_CHECK(NVIC_Fault_GetCount() == 2U);
+}
+
+/* The report of a record, also cut to a short buffer */
+static void Test_Format(void) {
+    static const char Expected[] =
+        "Fault #7: Bus Fault at PC 0x00001234 (thread stack PSP)\n"
+        "  Hard: escalated from a configurable fault\n"
+        "  Bus: precise data access error\n"
+        "  Bus fault address 0x40001000\n"
+        "  R0  0x00000000  R1 0x00000001  R2 0x00000002  R3   0x00000003\n"
+        "  R12 0x00000004  LR 0x00000005  PC 0x00001234  xPSR 0x01000000\n"
+        "  CFSR 0x00008200  HFSR 0x40000000  EXC_RETURN 0xFFFFFFFD\n";
+    NVIC_FaultRecordType Record;
+    char Buffer[1024];
+    uint32 Index;
+    uint32 Length;
+
+    Record.Sequence = 7U;
+    Record.Kind = EXCEPTION_BUS_FAULT_TYPE;
+    for (Index = 0; Index < NVIC_FAULT_FRAME_WORDS; Index++) {
+        Record.Frame[Index] = Index;
+    }
+    Record.Frame[NVIC_FAULT_FRAME_PC] = TEST_PC;
+    Record.Frame[NVIC_FAULT_FRAME_XPSR] = 0x01000000UL;
+    Record.ExcReturn = TEST_EXC_RETURN_PSP;
+    Record.FaultStat = FAULTSTAT_PRECISE_MASK | FAULTSTAT_BFARV_MASK;
+    Record.HFaultStat = HFAULTSTAT_FORCED_MASK;
+    Record.MmAddr = 0;
+    Record.FaultAddr = 0x40001000UL;
+
+    Length = NVIC_Fault_Format(&Record, Buffer, sizeof(Buffer));
+    TEST_CHECK(strcmp(Buffer, Expected) == 0);
+    TEST_CHECK(Length == strlen(Expected));
+
+    /* Truncated reports keep what fit and stay terminated */
+    Length = NVIC_Fault_Format(&Record, Buffer, 20U);
+    TEST_CHECK(Length == 19U);
+    TEST_CHECK(strncmp(Buffer, Expected, 19U) == 0);
+    TEST_CHECK(Buffer[19] == '\0');
+    TEST_CHECK(NVIC_Fault_Format(&Record, Buffer, 1U) == 0U);
+    TEST_CHECK(Buffer[0] == '\0');
+    TEST_CHECK(NVIC_Fault_Format(&Record, Buffer, 0U) == 0U);
+    TEST_CHECK(NVIC_Fault_Format(NULL_PTR, Buffer, sizeof(Buffer)) == 0U);
+
+    /* Every cause, and a frame that was never stacked */
+    Record.Kind = 99U;
+    Record.ExcReturn = 0xFFFFFFF9UL;
+    Record.FaultStat = 0xFFFFFFFFUL;
+    Record.HFaultStat = 0xFFFFFFFFUL;
+    Length = NVIC_Fault_Format(&Record, Buffer, sizeof(Buffer));
+    TEST_CHECK(Length == strlen(Buffer));
+    TEST_CHECK(strncmp(Buffer, "Fault #7: Unknown Fault at PC 0x00001234 (main stack MSP)\n", 58U) == 0);
+    TEST_CHECK(strstr(Buffer, "  Usage: divide by zero\n") != NULL_PTR);
+    TEST_CHECK(strstr(Buffer, "  Hard: debug event\n") != NULL_PTR);
+    TEST_CHECK(strstr(Buffer, "  Frame not captured, the fault hit its stacking\n") != NULL_PTR);
+    TEST_CHECK(strstr(Buffer, "R12") == NULL_PTR);
+}
+
+int main(void) {
+    Test_Capture();
+    Test_Ring();
+    Test_Recover();
+    Test_Stacking();
+    Test_Format();
+    return TEST_REPORT();
+}
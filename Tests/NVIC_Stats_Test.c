@@ -0,0 +1,201 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Stats_Test.c
+ *
+ * Description: Host test of the per-IRQ instrumentation. Handlers advance the
+ *              simulated DWT cycle counter by known amounts, so the entry count,
+ *              run time and entry latency of each record are checked exactly, both
+ *              through direct dispatches and through IRQs taken by the simulator.
+ *              Also checks that a snapshot is refused while its record is mid-update.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+
+#include "NVIC_Test.h"
+
+/* The records are compiled in here so the test can hold one mid-update */
+#include "NVIC.h"
+#include "NVIC_Sim.h"
+#include "NVIC_Stats.c"
+
+#if !NVIC_STATS_ENABLE
+#error "NVIC_Stats_Test.c needs NVIC_STATS_ENABLE set to 1"
+#endif
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+/* Cycles the next handler run takes */
+static uint32 Test_HandlerCycles;
+static uint32 Test_HandlerRuns;
+
+/* Stand-in for the startup vector table */
+static const NVIC_HandlerType Test_FlashTable[NVIC_VECTOR_COUNT];
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+static void Test_Handler(void) {
+    NVIC_Sim_AdvanceCycles(Test_HandlerCycles);
+    Test_HandlerRuns++;
+}
+
+NVIC_STATS_ISR(Test_Uart0Isr, NVIC_IRQ_UART0, Test_Handler)
+
+static void Test_Setup(void) {
+    NVIC_Sim_Reset();
+    NVIC_Stats_Init();
+    Test_HandlerRuns = 0;
+}
+
+/* Entry count, total and longest run time of direct dispatches */
+static void Test_RunTime(void) {
+    NVIC_StatsRecordType Snapshot;
+
+    Test_Setup();
+    TEST_CHECK(NVIC_Stats_GetSnapshot(NVIC_IRQ_UART0, &Snapshot) == TRUE);
+    TEST_CHECK(Snapshot.Entries == 0U);
+    TEST_CHECK(Snapshot.TotalCycles == 0U);
+
+    Test_HandlerCycles = 100U;
+    NVIC_Stats_Dispatch(NVIC_IRQ_UART0, Test_Handler);
+    Test_HandlerCycles = 300U;
+    NVIC_Stats_Dispatch(NVIC_IRQ_UART0, Test_Handler);
+    Test_HandlerCycles = 50U;
+    NVIC_Stats_Dispatch(NVIC_IRQ_UART0, Test_Handler);
+
+    TEST_CHECK(Test_HandlerRuns == 3U);
+    TEST_CHECK(NVIC_Stats_GetSnapshot(NVIC_IRQ_UART0, &Snapshot) == TRUE);
+    TEST_CHECK(Snapshot.Entries == 3U);
+    TEST_CHECK(Snapshot.TotalCycles == 450U);
+    TEST_CHECK(Snapshot.MaxCycles == 300U);
+    TEST_CHECK(Snapshot.MaxLatency == 0U);
+
+    /* Other records are untouched */
+    TEST_CHECK(NVIC_Stats_GetSnapshot(NVIC_IRQ_GPIO_PORTF, &Snapshot) == TRUE);
+    TEST_CHECK(Snapshot.Entries == 0U);
+
+    /* TotalCycles is 64-bit and does not wrap with CYCCNT */
+    Test_HandlerCycles = 0xF0000000UL;
+    NVIC_Stats_Dispatch(NVIC_IRQ_UART0, Test_Handler);
+    NVIC_Stats_Dispatch(NVIC_IRQ_UART0, Test_Handler);
+    TEST_CHECK(NVIC_Stats_GetSnapshot(NVIC_IRQ_UART0, &Snapshot) == TRUE);
+    TEST_CHECK(Snapshot.TotalCycles == 450U + 2U * (uint64)0xF0000000UL);
+    TEST_CHECK(Snapshot.MaxCycles == 0xF0000000UL);
+}
+
+/* Latency of a marked trigger, consumed by the next entry only */
+static void Test_Latency(void) {
+    NVIC_StatsRecordType Snapshot;
+
+    Test_Setup();
+    Test_HandlerCycles = 10U;
+    NVIC_Stats_MarkTrigger(NVIC_IRQ_UART0, NVIC_STATS_NOW());
+    NVIC_Sim_AdvanceCycles(40U);
+    NVIC_Stats_Dispatch(NVIC_IRQ_UART0, Test_Handler);
+    TEST_CHECK(NVIC_Stats_GetSnapshot(NVIC_IRQ_UART0, &Snapshot) == TRUE);
+    TEST_CHECK(Snapshot.MaxLatency == 40U);
+
+    /* An unmarked entry leaves the latency alone, a shorter one does not lower it */
+    NVIC_Sim_AdvanceCycles(500U);
+    NVIC_Stats_Dispatch(NVIC_IRQ_UART0, Test_Handler);
+    NVIC_Stats_MarkTrigger(NVIC_IRQ_UART0, NVIC_STATS_NOW());
+    NVIC_Sim_AdvanceCycles(20U);
+    NVIC_Stats_Dispatch(NVIC_IRQ_UART0, Test_Handler);
+    TEST_CHECK(NVIC_Stats_GetSnapshot(NVIC_IRQ_UART0, &Snapshot) == TRUE);
+    TEST_CHECK(Snapshot.MaxLatency == 40U);
+    TEST_CHECK(Snapshot.Entries == 3U);
+
+    /* Stamp taken before CYCCNT wrapped */
+    NVIC_WRITE32(NVIC_DWT_CYCCNT_ADDR, 0xFFFFFFF0UL);
+    NVIC_Stats_MarkTrigger(NVIC_IRQ_UART0, NVIC_STATS_NOW());
+    NVIC_Sim_AdvanceCycles(0x50U);
+    NVIC_Stats_Dispatch(NVIC_IRQ_UART0, Test_Handler);
+    TEST_CHECK(NVIC_Stats_GetSnapshot(NVIC_IRQ_UART0, &Snapshot) == TRUE);
+    TEST_CHECK(Snapshot.MaxLatency == 0x50U);
+    TEST_CHECK(Snapshot.MaxCycles == 10U);
+}
+
+/* IRQs taken by the simulator through an NVIC_STATS_ISR handler: the latency is the entry cost */
+static void Test_TakenIRQ(void) {
+    NVIC_StatsRecordType Snapshot;
+
+    Test_Setup();
+    NVIC_RelocateVectorTable(Test_FlashTable);
+    NVIC_SetHandler(NVIC_IRQ_UART0, Test_Uart0Isr);
+    NVIC_EnableIRQ(NVIC_IRQ_UART0);
+    Enable_Exceptions();
+
+    Test_HandlerCycles = 75U;
+    NVIC_Stats_MarkTrigger(NVIC_IRQ_UART0, NVIC_STATS_NOW());
+    NVIC_TriggerIRQ(NVIC_IRQ_UART0);
+    TEST_CHECK(NVIC_Sim_TakeIRQ(NVIC_IRQ_UART0) == TRUE);
+    TEST_CHECK(NVIC_Sim_TakeIRQ(NVIC_IRQ_UART0) == FALSE);
+
+    TEST_CHECK(Test_HandlerRuns == 1U);
+    TEST_CHECK(NVIC_Stats_GetSnapshot(NVIC_IRQ_UART0, &Snapshot) == TRUE);
+    TEST_CHECK(Snapshot.Entries == 1U);
+    TEST_CHECK(Snapshot.TotalCycles == 75U);
+    TEST_CHECK(Snapshot.MaxLatency == NVIC_SIM_ENTRY_CYCLES);
+}
+
+/* A record mid-update is never copied, and the retries run out while it stays so */
+static void Test_Snapshot(void) {
+    NVIC_StatsRecordType Snapshot;
+
+    Test_Setup();
+    Test_HandlerCycles = 30U;
+    NVIC_Stats_Dispatch(NVIC_IRQ_UART0, Test_Handler);
+
+    Snapshot.Entries = 0xDEADU;
+    NVIC_StatsEntries[NVIC_IRQ_UART0].Sequence++;
+    TEST_CHECK(NVIC_Stats_GetSnapshot(NVIC_IRQ_UART0, &Snapshot) == FALSE);
+    TEST_CHECK(Snapshot.Entries == 0xDEADU);
+    NVIC_StatsEntries[NVIC_IRQ_UART0].Sequence++;
+    TEST_CHECK(NVIC_Stats_GetSnapshot(NVIC_IRQ_UART0, &Snapshot) == TRUE);
+    TEST_CHECK(Snapshot.Entries == 1U);
+    TEST_CHECK(Snapshot.MaxCycles == 30U);
+
+    TEST_CHECK(NVIC_Stats_GetSnapshot(NVIC_IRQ_UART0, NULL_PTR) == FALSE);
+    TEST_CHECK(NVIC_Stats_GetSnapshot((NVIC_IRQType)NVIC_IRQ_COUNT, &Snapshot) == FALSE);
+}
+
+/* Clearing drops the counters and any pending trigger mark; out-of-range IRQs are not recorded */
+static void Test_Clear(void) {
+    NVIC_StatsRecordType Snapshot;
+
+    Test_Setup();
+    Test_HandlerCycles = 30U;
+    NVIC_Stats_Dispatch(NVIC_IRQ_UART0, Test_Handler);
+    NVIC_Stats_MarkTrigger(NVIC_IRQ_UART0, NVIC_STATS_NOW());
+    NVIC_Stats_Clear(NVIC_IRQ_UART0);
+    NVIC_Sim_AdvanceCycles(1000U);
+    NVIC_Stats_Dispatch(NVIC_IRQ_UART0, Test_Handler);
+    TEST_CHECK(NVIC_Stats_GetSnapshot(NVIC_IRQ_UART0, &Snapshot) == TRUE);
+    TEST_CHECK(Snapshot.Entries == 1U);
+    TEST_CHECK(Snapshot.TotalCycles == 30U);
+    TEST_CHECK(Snapshot.MaxLatency == 0U);
+
+    NVIC_Stats_Dispatch((NVIC_IRQType)NVIC_IRQ_COUNT, Test_Handler);
+    NVIC_Stats_MarkTrigger((NVIC_IRQType)NVIC_IRQ_COUNT, 0U);
+    NVIC_Stats_Clear((NVIC_IRQType)NVIC_IRQ_COUNT);
+    TEST_CHECK(Test_HandlerRuns == 3U);
+}
+
+int main(void) {
+    Test_RunTime();
+    Test_Latency();
+    Test_TakenIRQ();
+    Test_Snapshot();
+    Test_Clear();
+    return TEST_REPORT();
+}
@@ -0,0 +1,222 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Storm_Test.c
+ *
+ * Description: Host test of the interrupt storm limiter against the simulator
+ *              registers. Drives NVIC_Storm_Entry/NVIC_Storm_Tick the way the ISRs
+ *              and SysTick would and checks the budget crossing, the window reset,
+ *              the back-off re-enable and the throttle counters, also while the
+ *              thread holds an NVIC_BeginUpdate open.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+
+#include "NVIC_Test.h"
+
+/* The limiter is compiled in here so the budgets come from its own table */
+#include "NVIC.h"
+#include "NVIC_Sim.h"
+#include "NVIC_Storm.c"
+
+#if !NVIC_STORM_ENABLE
+#error "NVIC_Storm_Test.c needs NVIC_STORM_ENABLE set to 1"
+#endif
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+/* Configured budget and back-off of a rate-limited IRQ */
+#define TEST_BUDGET(IRQ_Num)                 (NVIC_StormConfig[NVIC_STORM_SLOT_##IRQ_Num].Budget)
+#define TEST_BACKOFF(IRQ_Num)                (NVIC_StormConfig[NVIC_STORM_SLOT_##IRQ_Num].BackoffTicks)
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+/* State of the ENn bit in the simulated NVIC, not in the driver shadow */
+static boolean Test_IsEnabledInHardware(NVIC_IRQType IRQ_Num) {
+    return ((NVIC_READ32(NVIC_EN_ADDR(NVIC_IRQ_WORD(IRQ_Num))) & NVIC_IRQ_BIT(IRQ_Num)) != 0) ? TRUE : FALSE;
+}
+
+static void Test_Setup(void) {
+    NVIC_Sim_Reset();
+    NVIC_SyncShadow();
+    NVIC_Storm_Init();
+    NVIC_EnableIRQ(NVIC_IRQ_GPIO_PORTF);
+    NVIC_EnableIRQ(NVIC_IRQ_CAN0);
+    NVIC_EnableIRQ(NVIC_IRQ_UART0);
+}
+
+static void Test_Ticks(uint32 Count) {
+    uint32 Tick;
+    for (Tick = 0; Tick < Count; Tick++) {
+        NVIC_Storm_Tick();
+    }
+}
+
+/* Returns the entry, counted from 1, that throttled the IRQ, 0 if none did */
+static uint32 Test_Entries(NVIC_IRQType IRQ_Num, uint32 Count) {
+    uint32 Entry;
+    uint32 Throttled = 0;
+    for (Entry = 1; Entry <= Count; Entry++) {
+        if ((NVIC_Storm_Entry(IRQ_Num) == TRUE) && (Throttled == 0U)) {
+            Throttled = Entry;
+        }
+    }
+    return Throttled;
+}
+
+/* Budget entries pass, the next one disables the IRQ, entries still in flight do not throttle again */
+static void Test_BudgetCrossing(void) {
+    Test_Setup();
+    TEST_CHECK(Test_Entries(NVIC_IRQ_GPIO_PORTF, TEST_BUDGET(NVIC_IRQ_GPIO_PORTF)) == 0U);
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_GPIO_PORTF) == TRUE);
+    TEST_CHECK(NVIC_Storm_IsThrottled(NVIC_IRQ_GPIO_PORTF) == FALSE);
+
+    TEST_CHECK(NVIC_Storm_Entry(NVIC_IRQ_GPIO_PORTF) == TRUE);
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_GPIO_PORTF) == FALSE);
+    TEST_CHECK(NVIC_IsIRQEnabled(NVIC_IRQ_GPIO_PORTF) == FALSE);
+    TEST_CHECK(NVIC_Storm_IsThrottled(NVIC_IRQ_GPIO_PORTF) == TRUE);
+    TEST_CHECK(NVIC_Storm_GetThrottleCount(NVIC_IRQ_GPIO_PORTF) == 1U);
+
+    TEST_CHECK(Test_Entries(NVIC_IRQ_GPIO_PORTF, 5U) == 0U);
+    TEST_CHECK(NVIC_Storm_GetThrottleCount(NVIC_IRQ_GPIO_PORTF) == 1U);
+
+    /* The other sources are left alone */
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_CAN0) == TRUE);
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_UART0) == TRUE);
+    TEST_CHECK(NVIC_Storm_GetThrottleCount(NVIC_IRQ_CAN0) == 0U);
+}
+
+/* The count restarts every window, so a source that stays within its budget is never throttled */
+static void Test_WindowReset(void) {
+    uint32 Window;
+
+    Test_Setup();
+    for (Window = 0; Window < 50U; Window++) {
+        TEST_CHECK(Test_Entries(NVIC_IRQ_GPIO_PORTF, TEST_BUDGET(NVIC_IRQ_GPIO_PORTF)) == 0U);
+        Test_Ticks(NVIC_STORM_WINDOW_TICKS);
+    }
+    TEST_CHECK(NVIC_Storm_GetThrottleCount(NVIC_IRQ_GPIO_PORTF) == 0U);
+
+    /* Mid-window ticks keep counting */
+    TEST_CHECK(Test_Entries(NVIC_IRQ_GPIO_PORTF, TEST_BUDGET(NVIC_IRQ_GPIO_PORTF)) == 0U);
+    Test_Ticks(NVIC_STORM_WINDOW_TICKS - 1U);
+    TEST_CHECK(NVIC_Storm_Entry(NVIC_IRQ_GPIO_PORTF) == TRUE);
+}
+
+/* The IRQ comes back after exactly its back-off, with a fresh window, and can be throttled again */
+static void Test_Backoff(void) {
+    Test_Setup();
+    TEST_CHECK(Test_Entries(NVIC_IRQ_CAN0, TEST_BUDGET(NVIC_IRQ_CAN0) + 1U) == TEST_BUDGET(NVIC_IRQ_CAN0) + 1U);
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_CAN0) == FALSE);
+
+    Test_Ticks(TEST_BACKOFF(NVIC_IRQ_CAN0) - 1U);
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_CAN0) == FALSE);
+    TEST_CHECK(NVIC_Storm_IsThrottled(NVIC_IRQ_CAN0) == TRUE);
+    Test_Ticks(1U);
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_CAN0) == TRUE);
+    TEST_CHECK(NVIC_IsIRQEnabled(NVIC_IRQ_CAN0) == TRUE);
+    TEST_CHECK(NVIC_Storm_IsThrottled(NVIC_IRQ_CAN0) == FALSE);
+
+    TEST_CHECK(Test_Entries(NVIC_IRQ_CAN0, TEST_BUDGET(NVIC_IRQ_CAN0)) == 0U);
+    TEST_CHECK(NVIC_Storm_Entry(NVIC_IRQ_CAN0) == TRUE);
+    TEST_CHECK(NVIC_Storm_GetThrottleCount(NVIC_IRQ_CAN0) == 2U);
+    Test_Ticks(TEST_BACKOFF(NVIC_IRQ_CAN0));
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_CAN0) == TRUE);
+    TEST_CHECK(NVIC_Storm_GetThrottleCount(NVIC_IRQ_CAN0) == 2U);
+
+    NVIC_Storm_Init();
+    TEST_CHECK(NVIC_Storm_GetThrottleCount(NVIC_IRQ_CAN0) == 0U);
+}
+
+/* A NVIC_MaskSet scope over the throttled IRQ keeps it masked for as long as the
+ * scope is open, whichever of the scope and the back-off ends first */
+static void Test_ScopeDuringBackoff(void) {
+    NVIC_IRQMaskType Shared = { { 0 } };
+    NVIC_MaskTokenType Token;
+
+    NVIC_IRQ_MASK_ADD(Shared, NVIC_IRQ_CAN0);
+    NVIC_IRQ_MASK_ADD(Shared, NVIC_IRQ_UART0);
+    Test_Setup();
+
+    /* Back-off ends inside the scope: the IRQ stays masked until the scope closes */
+    TEST_CHECK(Test_Entries(NVIC_IRQ_CAN0, TEST_BUDGET(NVIC_IRQ_CAN0) + 1U) != 0U);
+    Token = NVIC_MaskSet(&Shared);
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_UART0) == FALSE);
+    Test_Ticks(TEST_BACKOFF(NVIC_IRQ_CAN0));
+    TEST_CHECK(NVIC_Storm_IsThrottled(NVIC_IRQ_CAN0) == FALSE);
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_CAN0) == FALSE);
+    NVIC_UnmaskSet(&Token);
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_CAN0) == TRUE);
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_UART0) == TRUE);
+
+    /* Scope closes inside the back-off: the IRQ stays throttled until the back-off ends */
+    TEST_CHECK(Test_Entries(NVIC_IRQ_CAN0, TEST_BUDGET(NVIC_IRQ_CAN0) + 1U) != 0U);
+    Token = NVIC_MaskSet(&Shared);
+    NVIC_UnmaskSet(&Token);
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_CAN0) == FALSE);
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_UART0) == TRUE);
+    Test_Ticks(TEST_BACKOFF(NVIC_IRQ_CAN0));
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_CAN0) == TRUE);
+
+    /* Throttled by an entry already in flight when the scope opened: the scope owns the re-enable */
+    Token = NVIC_MaskSet(&Shared);
+    TEST_CHECK(Test_Entries(NVIC_IRQ_CAN0, TEST_BUDGET(NVIC_IRQ_CAN0) + 1U) != 0U);
+    Test_Ticks(TEST_BACKOFF(NVIC_IRQ_CAN0));
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_CAN0) == FALSE);
+    NVIC_UnmaskSet(&Token);
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_CAN0) == TRUE);
+    TEST_CHECK(NVIC_Storm_GetThrottleCount(NVIC_IRQ_CAN0) == 3U);
+}
+
+/* Throttle and re-enable reach the hardware while an update is open, and the commit keeps them */
+static void Test_OpenUpdate(void) {
+    Test_Setup();
+    NVIC_BeginUpdate();
+    TEST_CHECK(Test_Entries(NVIC_IRQ_GPIO_PORTF, TEST_BUDGET(NVIC_IRQ_GPIO_PORTF) + 1U) != 0U);
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_GPIO_PORTF) == FALSE);
+    NVIC_CommitUpdate();
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_GPIO_PORTF) == FALSE);
+
+    NVIC_BeginUpdate();
+    Test_Ticks(TEST_BACKOFF(NVIC_IRQ_GPIO_PORTF));
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_GPIO_PORTF) == TRUE);
+    NVIC_CommitUpdate();
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_GPIO_PORTF) == TRUE);
+    TEST_CHECK(NVIC_IsIRQEnabled(NVIC_IRQ_GPIO_PORTF) == TRUE);
+}
+
+/* IRQs outside the table are never counted */
+static void Test_Unlisted(void) {
+    Test_Setup();
+    TEST_CHECK(Test_Entries(NVIC_IRQ_UART0, 10000U) == 0U);
+    TEST_CHECK(Test_IsEnabledInHardware(NVIC_IRQ_UART0) == TRUE);
+    TEST_CHECK(NVIC_Storm_IsThrottled(NVIC_IRQ_UART0) == FALSE);
+    TEST_CHECK(NVIC_Storm_GetThrottleCount(NVIC_IRQ_UART0) == 0U);
+    TEST_CHECK(NVIC_Storm_Entry((NVIC_IRQType)NVIC_IRQ_COUNT) == FALSE);
+    TEST_CHECK(NVIC_Storm_IsThrottled((NVIC_IRQType)NVIC_IRQ_COUNT) == FALSE);
+    TEST_CHECK(NVIC_Storm_GetThrottleCount((NVIC_IRQType)NVIC_IRQ_COUNT) == 0U);
+}
+
+int main(void) {
+    Test_BudgetCrossing();
+    Test_WindowReset();
+    Test_Backoff();
+    Test_ScopeDuringBackoff();
+    Test_OpenUpdate();
+    Test_Unlisted();
+    return TEST_REPORT();
+}
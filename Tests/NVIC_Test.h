@@ -0,0 +1,54 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Test.h
+ *
+ * Description: Fixture shared by the host tests of the NVIC driver. A test
+ *              Tests/NVIC_<Module>_Test.c #includes the NVIC_<Module>.c it checks,
+ *              to reach its private state or hook its build, and is linked with
+ *              every other driver source against the simulator (Tests/run_tests.sh).
+ *              It reports each failed check and exits non-zero if any failed.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_TEST_H_
+#define NVIC_TEST_H_
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+#include <stdio.h>
+#include "std_types.h"
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+/* Count and print a failed check, the test goes on */
+#define TEST_CHECK(Condition)                                                   \
+    do {                                                                        \
+        if (!(Condition)) {                                                     \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #Condition);         \
+            Test_Failures++;                                                    \
+        }                                                                       \
+    } while (0)
+
+/* Print the failure count of the test, evaluates to its exit status */
+#define TEST_REPORT()                                                           \
+    (printf("%s: %u failure(s)\n", __FILE__, (unsigned)Test_Failures),          \
+     (Test_Failures == 0U) ? 0 : 1)
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+static uint32 Test_Failures;
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_TEST_H_ */
@@ -0,0 +1,68 @@
+#!/bin/sh
+#
+# Builds every Tests/NVIC_<Module>_Test.c against the host simulator and runs it,
+# once with the enable shadow off and once with it on. Each test compiles its own
+# NVIC_<Module>.c in, so that source is left out of the link. Then checks the
+# register access cost of each API call against Tools/NVIC_Baseline.txt and runs
+# the static analysis of NVIC_Cfg.h.
+#
+# Usage: Tests/run_tests.sh <dir of std_types.h>
+#
+# Exits non-zero when a test fails to build or reports a failure, a call got
+# more expensive than recorded, or the analyzer reports a violation or error.
+
+set -u
+
+if [ $# -ne 1 ]; then
+    echo "usage: $0 <dir of std_types.h>" >&2
+    exit 2
+fi
+
+STD_TYPES_DIR=$1
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+BUILD_DIR=$(mktemp -d)
+trap 'rm -rf "$BUILD_DIR"' EXIT
+
+CC=${CC:-gcc}
+CFLAGS="-std=gnu99 -O2 -Wall -Wextra -pthread -DNVIC_HOST_SIM -DNVIC_STATS_ENABLE=1 -DNVIC_STORM_ENABLE=1 -DNVIC_FAULT_ENABLE=1"
+
+FAILED=0
+for TEST in "$ROOT"/Tests/NVIC_*_Test.c; do
+    NAME=$(basename "$TEST" .c)
+    MODULE=${NAME%_Test}.c
+    SOURCES=$(ls "$ROOT"/NVIC_Driver/*.c | grep -v "/$MODULE\$")
+    for SHADOW in 0 1; do
+        BINARY="$BUILD_DIR/$NAME.$SHADOW"
+        # shellcheck disable=SC2086
+        if ! $CC $CFLAGS -DNVIC_SHADOW_ENABLE=$SHADOW -I"$STD_TYPES_DIR" -I"$ROOT/NVIC_Driver" \
+                -o "$BINARY" "$TEST" $SOURCES; then
+            echo "$NAME (shadow $SHADOW): build failed"
+            FAILED=1
+        elif ! "$BINARY"; then
+            echo "$NAME (shadow $SHADOW): failed"
+            FAILED=1
+        fi
+    done
+done
+
+# Register access cost of the shipped configuration against the recorded baseline
+if ! $CC -std=c99 -DNVIC_HOST_SIM -I"$STD_TYPES_DIR" -I"$ROOT/NVIC_Driver" -o "$BUILD_DIR/nvic_baseline" \
+        "$ROOT/Tools/NVIC_Baseline.c" "$ROOT"/NVIC_Driver/*.c; then
+    echo "NVIC_Baseline: build failed"
+    FAILED=1
+elif ! "$BUILD_DIR/nvic_baseline" "$ROOT/Tools/NVIC_Baseline.txt"; then
+    echo "NVIC_Baseline: costs above Tools/NVIC_Baseline.txt"
+    FAILED=1
+fi
+
+# Static analysis of the shipped configuration: a violation or a configuration error fails
+if ! $CC -std=c99 -DNVIC_HOST_SIM -I"$STD_TYPES_DIR" -I"$ROOT/NVIC_Driver" -o "$BUILD_DIR/nvic_analyze" \
+        "$ROOT/Tools/NVIC_Analyze.c"; then
+    echo "NVIC_Analyze: build failed"
+    FAILED=1
+elif ! "$BUILD_DIR/nvic_analyze"; then
+    echo "NVIC_Analyze: the configuration fails its timing budgets"
+    FAILED=1
+fi
+
+exit $FAILED
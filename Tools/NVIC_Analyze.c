@@ -0,0 +1,428 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Analyze.c
+ *
+ * Description: Host-side static analyzer of the NVIC configuration. Reads the priority
+ *              grouping, the IRQ/exception priorities and the timing budgets of
+ *              NVIC_Cfg.h at compile time and computes the worst-case response time of
+ *              every recurring handler and the worst-case main stack depth of nested
+ *              preemption. Exits non-zero on a missed deadline, a request that can be
+ *              lost while still pending, a stack overflow or an incomplete budget table,
+ *              so running it fails the build. See README.md for the build command.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include "NVIC.h"
+#include "NVIC_Cfg.h"
+#include "NVIC_Fpu.h"
+#include "NVIC_Sim.h"
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+/* Exception frame of the simulator cost model, plus 4 bytes of 8-byte alignment padding */
+#define NVIC_ANALYZE_BASIC_FRAME_BYTES       ((NVIC_SIM_BASIC_FRAME_WORDS * 4U) + 4U)
+#define NVIC_ANALYZE_EXTENDED_FRAME_BYTES    ((NVIC_SIM_EXTENDED_FRAME_WORDS * 4U) + 4U)
+
+/* Preemption levels of the fixed-priority exceptions, above every configurable level */
+#define NVIC_ANALYZE_NMI_LEVEL               (-2)
+#define NVIC_ANALYZE_HARD_FAULT_LEVEL        (-1)
+
+/* Vector number of IRQ 0, the order of equal priorities follows the vector number */
+#define NVIC_ANALYZE_IRQ_VECTOR_OFFSET       16U
+
+/* Exit status */
+#define NVIC_ANALYZE_EXIT_OK                 0
+#define NVIC_ANALYZE_EXIT_VIOLATION          1
+#define NVIC_ANALYZE_EXIT_CONFIG_ERROR       2
+
+/* Every IRQ timing entry must name an implemented, non-reserved IRQ */
+#define NVIC_ANALYZE_CHECK_IRQ(IRQ_Num, Wcet_Cycles, Stack_Bytes, Deadline_Cycles, Interarrival_Cycles) \
+    typedef char NVIC_AnalyzeCheck_##IRQ_Num[NVIC_IRQ_IS_VALID(IRQ_Num) ? 1 : -1];
+
+NVIC_CFG_IRQ_TIMING_TABLE(NVIC_ANALYZE_CHECK_IRQ)
+
+/*******************************************************************************
+ * DATA TYPES DDECLERATIONS                                                    *
+ *******************************************************************************/
+
+/* One row of the timing tables */
+typedef struct
+{
+    const char *Name;
+    boolean IsIRQ;
+    uint32 Number;              /* NVIC_IRQType or NVIC_ExceptionType */
+    uint32 WcetCycles;
+    uint32 StackBytes;
+    uint32 DeadlineCycles;
+    uint32 InterarrivalCycles;
+} NVIC_AnalyzeBudgetType;
+
+/* One row of the priority tables */
+typedef struct
+{
+    uint32 Number;
+    uint32 Priority;
+    boolean Enabled;
+} NVIC_AnalyzePriorityType;
+
+/* A handler as seen by the analysis */
+typedef struct
+{
+    const NVIC_AnalyzeBudgetType *Budget;
+    sint32 Level;               /* Preemption level, a lower level preempts a higher one  */
+    uint32 Sub;                 /* Sub-priority inside the level                          */
+    uint32 Vector;              /* Vector number, orders equal priorities                 */
+    uint64 Cost;                /* WCET plus entry/exit cycles                            */
+    uint32 Stack;               /* Handler stack plus exception frame                     */
+    boolean Recurring;
+} NVIC_AnalyzeSourceType;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+#define NVIC_ANALYZE_IRQ_BUDGET(IRQ_Num, Wcet_Cycles, Stack_Bytes, Deadline_Cycles, Interarrival_Cycles) \
+    { #IRQ_Num, TRUE, (uint32)(IRQ_Num), (Wcet_Cycles), (Stack_Bytes), (Deadline_Cycles), (Interarrival_Cycles) },
+#define NVIC_ANALYZE_EXCEPTION_BUDGET(Exception_Num, Wcet_Cycles, Stack_Bytes, Deadline_Cycles, Interarrival_Cycles) \
+    { #Exception_Num, FALSE, (uint32)(Exception_Num), (Wcet_Cycles), (Stack_Bytes), (Deadline_Cycles), (Interarrival_Cycles) },
+
+static const NVIC_AnalyzeBudgetType NVIC_AnalyzeBudgets[] = {
+    NVIC_CFG_IRQ_TIMING_TABLE(NVIC_ANALYZE_IRQ_BUDGET)
+    NVIC_CFG_EXCEPTION_TIMING_TABLE(NVIC_ANALYZE_EXCEPTION_BUDGET)
+};
+
+#define NVIC_ANALYZE_SOURCE_COUNT            (sizeof(NVIC_AnalyzeBudgets) / sizeof(NVIC_AnalyzeBudgets[0]))
+
+#define NVIC_ANALYZE_IRQ_PRIORITY(IRQ_Num, IRQ_Priority, Enabled) \
+    { (uint32)(IRQ_Num), (uint32)(IRQ_Priority), (Enabled) },
+#define NVIC_ANALYZE_IRQ_NAME(IRQ_Num, IRQ_Priority, Enabled)     #IRQ_Num,
+#define NVIC_ANALYZE_EXCEPTION_PRIORITY(Exception_Num, Exception_Priority, Enabled) \
+    { (uint32)(Exception_Num), (uint32)(Exception_Priority), (Enabled) },
+#define NVIC_ANALYZE_FPU_FREE(IRQ_Num)                            (uint32)(IRQ_Num),
+
+static const NVIC_AnalyzePriorityType NVIC_AnalyzeIRQPriorities[] = {
+    NVIC_CFG_IRQ_TABLE(NVIC_ANALYZE_IRQ_PRIORITY)
+};
+static const char *const NVIC_AnalyzeIRQNames[] = {
+    NVIC_CFG_IRQ_TABLE(NVIC_ANALYZE_IRQ_NAME)
+};
+static const NVIC_AnalyzePriorityType NVIC_AnalyzeExceptionPriorities[] = {
+    NVIC_CFG_EXCEPTION_TABLE(NVIC_ANALYZE_EXCEPTION_PRIORITY)
+};
+static const uint32 NVIC_AnalyzeFpuFree[] = {
+    NVIC_CFG_FPU_FREE_TABLE(NVIC_ANALYZE_FPU_FREE)
+};
+
+#define NVIC_ANALYZE_COUNT(Array)            ((uint32)(sizeof(Array) / sizeof((Array)[0])))
+
+/* Vector number of each NVIC_ExceptionType */
+static const uint32 NVIC_AnalyzeExceptionVector[] = {
+    1U,     /* EXCEPTION_RESET_TYPE         */
+    2U,     /* EXCEPTION_NMI_TYPE           */
+    3U,     /* EXCEPTION_HARD_FAULT_TYPE    */
+    4U,     /* EXCEPTION_MEM_FAULT_TYPE     */
+    5U,     /* EXCEPTION_BUS_FAULT_TYPE     */
+    6U,     /* EXCEPTION_USAGE_FAULT_TYPE   */
+    11U,    /* EXCEPTION_SVC_TYPE           */
+    12U,    /* EXCEPTION_DEBUG_MONITOR_TYPE */
+    14U,    /* EXCEPTION_PEND_SV_TYPE       */
+    15U,    /* EXCEPTION_SYSTICK_TYPE       */
+};
+
+static NVIC_AnalyzeSourceType NVIC_AnalyzeSources[NVIC_ANALYZE_SOURCE_COUNT];
+
+/*******************************************************************************
+ * PRIVATE FUNCTION DEFINITIONS                                                *
+ *******************************************************************************/
+
+static const NVIC_AnalyzePriorityType *NVIC_Analyze_FindPriority(const NVIC_AnalyzePriorityType *Table,
+                                                                 uint32 Count, uint32 Number) {
+    uint32 Index;
+    for (Index = 0; Index < Count; Index++) {
+        if (Table[Index].Number == Number) {
+            return &Table[Index];
+        }
+    }
+    return NULL_PTR;
+}
+
+static boolean NVIC_Analyze_IsFpuFree(const NVIC_AnalyzeBudgetType *Budget) {
+    uint32 Index;
+    if (Budget->IsIRQ == FALSE) {
+        return FALSE;
+    }
+    for (Index = 0; Index < NVIC_ANALYZE_COUNT(NVIC_AnalyzeFpuFree); Index++) {
+        if (NVIC_AnalyzeFpuFree[Index] == Budget->Number) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* TRUE if Other is served before Source when both are pending at the same level */
+static boolean NVIC_Analyze_IsAhead(const NVIC_AnalyzeSourceType *Other, const NVIC_AnalyzeSourceType *Source) {
+    if (Other->Level != Source->Level) {
+        return (Other->Level < Source->Level) ? TRUE : FALSE;
+    }
+    if (Other->Sub != Source->Sub) {
+        return (Other->Sub < Source->Sub) ? TRUE : FALSE;
+    }
+    return (Other->Vector < Source->Vector) ? TRUE : FALSE;
+}
+
+/* Resolves priority, cost and stack of every budget row, returns the number of configuration errors.
+ * SubBits is the sub-priority width of the configured grouping */
+static uint32 NVIC_Analyze_BuildSources(uint32 SubBits) {
+    uint32 Errors = 0;
+    boolean FpFrames = (NVIC_FPU_STACKING != NVIC_FPU_STACKING_NONE) ? TRUE : FALSE;
+    const NVIC_AnalyzePriorityType *Priority;
+    NVIC_AnalyzeSourceType *Source;
+    uint32 Index;
+    uint32 Other;
+
+    for (Index = 0; Index < NVIC_ANALYZE_SOURCE_COUNT; Index++) {
+        Source = &NVIC_AnalyzeSources[Index];
+        Source->Budget = &NVIC_AnalyzeBudgets[Index];
+        Source->Recurring = (Source->Budget->InterarrivalCycles != 0U) ? TRUE : FALSE;
+
+        for (Other = 0; Other < Index; Other++) {
+            if ((NVIC_AnalyzeBudgets[Other].IsIRQ == Source->Budget->IsIRQ) &&
+                (NVIC_AnalyzeBudgets[Other].Number == Source->Budget->Number)) {
+                printf("error: %s has more than one timing entry\n", Source->Budget->Name);
+                Errors++;
+            }
+        }
+
+        if (Source->Budget->IsIRQ == TRUE) {
+            Source->Vector = NVIC_ANALYZE_IRQ_VECTOR_OFFSET + Source->Budget->Number;
+            Priority = NVIC_Analyze_FindPriority(NVIC_AnalyzeIRQPriorities,
+                                                 NVIC_ANALYZE_COUNT(NVIC_AnalyzeIRQPriorities), Source->Budget->Number);
+        } else if (Source->Budget->Number >= NVIC_ANALYZE_COUNT(NVIC_AnalyzeExceptionVector)) {
+            printf("error: %s is not an exception\n", Source->Budget->Name);
+            Errors++;
+            continue;
+        } else {
+            Source->Vector = NVIC_AnalyzeExceptionVector[Source->Budget->Number];
+            Priority = NVIC_Analyze_FindPriority(NVIC_AnalyzeExceptionPriorities,
+                                                 NVIC_ANALYZE_COUNT(NVIC_AnalyzeExceptionPriorities), Source->Budget->Number);
+        }
+
+        if ((Source->Budget->IsIRQ == FALSE) && (Source->Budget->Number == (uint32)EXCEPTION_NMI_TYPE)) {
+            Source->Level = NVIC_ANALYZE_NMI_LEVEL;
+            Source->Sub = 0;
+        } else if ((Source->Budget->IsIRQ == FALSE) && (Source->Budget->Number == (uint32)EXCEPTION_HARD_FAULT_TYPE)) {
+            Source->Level = NVIC_ANALYZE_HARD_FAULT_LEVEL;
+            Source->Sub = 0;
+        } else if ((Priority == NULL_PTR) ||
+                   ((Source->Budget->IsIRQ == FALSE) && (Source->Budget->Number == (uint32)EXCEPTION_RESET_TYPE))) {
+            printf("error: %s has a timing entry but no configured priority\n", Source->Budget->Name);
+            Errors++;
+            continue;
+        } else {
+            Source->Level = (sint32)(Priority->Priority >> SubBits);
+            Source->Sub = Priority->Priority & ((1UL << SubBits) - 1UL);
+        }
+
+        Source->Cost = (uint64)Source->Budget->WcetCycles + NVIC_SIM_ENTRY_CYCLES + NVIC_SIM_EXIT_CYCLES;
+        Source->Stack = Source->Budget->StackBytes + NVIC_ANALYZE_BASIC_FRAME_BYTES;
+        if (FpFrames == TRUE) {
+            /* The extended frame is reserved whenever the interrupted context owns FP
+             * state, the FP state itself is only moved if the handler may use the FPU */
+            Source->Stack = Source->Budget->StackBytes + NVIC_ANALYZE_EXTENDED_FRAME_BYTES;
+            if ((NVIC_FPU_STACKING == NVIC_FPU_STACKING_FULL) || (NVIC_Analyze_IsFpuFree(Source->Budget) == FALSE)) {
+                Source->Cost += 2U * NVIC_SIM_FP_STATE_CYCLES;
+            }
+        }
+    }
+
+    /* Every enabled IRQ must have a budget, or the analysis is not sound */
+    for (Index = 0; Index < NVIC_ANALYZE_COUNT(NVIC_AnalyzeIRQPriorities); Index++) {
+        if (NVIC_AnalyzeIRQPriorities[Index].Enabled == FALSE) {
+            continue;
+        }
+        for (Other = 0; Other < NVIC_ANALYZE_SOURCE_COUNT; Other++) {
+            if ((NVIC_AnalyzeBudgets[Other].IsIRQ == TRUE) &&
+                (NVIC_AnalyzeBudgets[Other].Number == NVIC_AnalyzeIRQPriorities[Index].Number)) {
+                break;
+            }
+        }
+        if (Other == NVIC_ANALYZE_SOURCE_COUNT) {
+            printf("error: %s is enabled but has no timing entry\n", NVIC_AnalyzeIRQNames[Index]);
+            Errors++;
+        }
+    }
+    return Errors;
+}
+
+/* Worst-case response time of a recurring source, fixed-priority preemptive within
+ * the preemption levels and non-preemptive inside a level:
+ *   R = B + C + sum over the sources served ahead of it of ceil(R / T) * C
+ * B is the longest handler of the same level that is not ahead of it, or the longest
+ * thread critical section. Returns FALSE when R grows past Limit */
+static boolean NVIC_Analyze_ResponseTime(const NVIC_AnalyzeSourceType *Source, uint64 Limit,
+                                         uint64 *Blocking, uint64 *Response) {
+    const NVIC_AnalyzeSourceType *Other;
+    uint64 Previous;
+    uint64 Next;
+    uint32 Index;
+
+    *Blocking = NVIC_ANALYSIS_THREAD_BLOCKING_CYCLES;
+    for (Index = 0; Index < NVIC_ANALYZE_SOURCE_COUNT; Index++) {
+        Other = &NVIC_AnalyzeSources[Index];
+        if ((Other != Source) && (Other->Level == Source->Level) &&
+            (NVIC_Analyze_IsAhead(Other, Source) == FALSE) && (Other->Cost > *Blocking)) {
+            *Blocking = Other->Cost;
+        }
+    }
+
+    Next = *Blocking + Source->Cost;
+    do {
+        Previous = Next;
+        Next = *Blocking + Source->Cost;
+        for (Index = 0; Index < NVIC_ANALYZE_SOURCE_COUNT; Index++) {
+            Other = &NVIC_AnalyzeSources[Index];
+            if ((Other != Source) && (Other->Recurring == TRUE) && (NVIC_Analyze_IsAhead(Other, Source) == TRUE)) {
+                Next += ((Previous + Other->Budget->InterarrivalCycles - 1U) / Other->Budget->InterarrivalCycles) * Other->Cost;
+            }
+        }
+        if (Next > Limit) {
+            *Response = Next;
+            return FALSE;
+        }
+    } while (Next != Previous);
+    *Response = Next;
+    return TRUE;
+}
+
+/* Worst-case main stack: the thread, then one handler per preemption level, each
+ * preempting the one below. Returns the depth and prints the nesting chain */
+static uint32 NVIC_Analyze_StackDepth(void) {
+    uint32 Depth = NVIC_ANALYSIS_THREAD_STACK_BYTES;
+    const NVIC_AnalyzeSourceType *Deepest;
+    sint32 Level;
+    sint32 MaxLevel = NVIC_ANALYZE_NMI_LEVEL;
+    uint32 Index;
+
+    for (Index = 0; Index < NVIC_ANALYZE_SOURCE_COUNT; Index++) {
+        if (NVIC_AnalyzeSources[Index].Level > MaxLevel) {
+            MaxLevel = NVIC_AnalyzeSources[Index].Level;
+        }
+    }
+    printf("  %-32s %6u\n", "thread", (unsigned)NVIC_ANALYSIS_THREAD_STACK_BYTES);
+    for (Level = MaxLevel; Level >= NVIC_ANALYZE_NMI_LEVEL; Level--) {
+        Deepest = NULL_PTR;
+        for (Index = 0; Index < NVIC_ANALYZE_SOURCE_COUNT; Index++) {
+            if ((NVIC_AnalyzeSources[Index].Level == Level) &&
+                ((Deepest == NULL_PTR) || (NVIC_AnalyzeSources[Index].Stack > Deepest->Stack))) {
+                Deepest = &NVIC_AnalyzeSources[Index];
+            }
+        }
+        if (Deepest != NULL_PTR) {
+            Depth += Deepest->Stack;
+            printf("  %-32s %6u  level %d\n", Deepest->Budget->Name, (unsigned)Deepest->Stack, (int)Level);
+        }
+    }
+    return Depth;
+}
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+int main(void) {
+    const NVIC_AnalyzeSourceType *Source;
+    const NVIC_AnalyzeSourceType *Other;
+    uint32 SubBits;
+    uint32 Violations = 0;
+    uint32 Errors;
+    uint64 Limit;
+    uint64 Blocking;
+    uint64 Response;
+    uint32 Depth;
+    uint32 Index;
+    uint32 OtherIndex;
+    boolean Bounded;
+
+    /* Checked here as well as in NVIC.c, the tool is built without the driver */
+    if (((uint32)NVIC_CFG_PRIORITY_GROUPING < (uint32)NVIC_PRIGROUP_ALL_PREEMPT) ||
+        ((uint32)NVIC_CFG_PRIORITY_GROUPING > (uint32)NVIC_PRIGROUP_NO_PREEMPT)) {
+        printf("error: NVIC_CFG_PRIORITY_GROUPING %u is not a PRIGROUP value of the part (%u to %u)\n",
+               (unsigned)NVIC_CFG_PRIORITY_GROUPING, (unsigned)NVIC_PRIGROUP_ALL_PREEMPT,
+               (unsigned)NVIC_PRIGROUP_NO_PREEMPT);
+        printf("1 configuration error(s)\n");
+        return NVIC_ANALYZE_EXIT_CONFIG_ERROR;
+    }
+    SubBits = (uint32)NVIC_CFG_PRIORITY_GROUPING - (uint32)NVIC_PRIGROUP_ALL_PREEMPT;
+
+    printf("NVIC configuration analysis: %u priority bits, %u preemption levels, %s stacking\n",
+           (unsigned)NVIC_PRIORITY_BITS, (unsigned)(1UL << (NVIC_PRIORITY_BITS - SubBits)),
+           (NVIC_FPU_STACKING == NVIC_FPU_STACKING_NONE) ? "basic" :
+           (NVIC_FPU_STACKING == NVIC_FPU_STACKING_FULL) ? "full FP" : "lazy FP");
+
+    Errors = NVIC_Analyze_BuildSources(SubBits);
+    if (Errors != 0U) {
+        printf("%u configuration error(s)\n", (unsigned)Errors);
+        return NVIC_ANALYZE_EXIT_CONFIG_ERROR;
+    }
+
+    printf("\n  %-32s %5s %3s %8s %10s %10s %8s %10s\n",
+           "source", "level", "sub", "cost", "period", "deadline", "block", "response");
+    for (Index = 0; Index < NVIC_ANALYZE_SOURCE_COUNT; Index++) {
+        Source = &NVIC_AnalyzeSources[Index];
+        if (Source->Recurring == FALSE) {
+            printf("  %-32s %5d %3u %8llu %10s %10s %8s %10s\n", Source->Budget->Name, (int)Source->Level,
+                   (unsigned)Source->Sub, (unsigned long long)Source->Cost, "-", "-", "-", "-");
+            continue;
+        }
+        /* Past the deadline, or past the period when there is none, the result no longer matters */
+        Limit = (Source->Budget->DeadlineCycles > Source->Budget->InterarrivalCycles) ?
+                Source->Budget->DeadlineCycles : Source->Budget->InterarrivalCycles;
+        Limit += Source->Cost;
+        Bounded = NVIC_Analyze_ResponseTime(Source, Limit, &Blocking, &Response);
+        printf("  %-32s %5d %3u %8llu %10u %10u %8llu %9s%llu\n", Source->Budget->Name, (int)Source->Level,
+               (unsigned)Source->Sub, (unsigned long long)Source->Cost, (unsigned)Source->Budget->InterarrivalCycles,
+               (unsigned)Source->Budget->DeadlineCycles, (unsigned long long)Blocking,
+               (Bounded == TRUE) ? "" : ">", (unsigned long long)Response);
+
+        if ((Source->Budget->DeadlineCycles != 0U) && (Response > Source->Budget->DeadlineCycles)) {
+            printf("    violation: response exceeds the deadline\n");
+            Violations++;
+        }
+        /* The NVIC holds one pending request per IRQ, a request arriving while the
+         * previous one has not started yet is merged into it */
+        if ((Response - Source->Cost) >= Source->Budget->InterarrivalCycles) {
+            printf("    violation: a request can arrive while the previous one is still pending and be lost\n");
+            Violations++;
+        }
+        for (OtherIndex = 0; OtherIndex < NVIC_ANALYZE_SOURCE_COUNT; OtherIndex++) {
+            Other = &NVIC_AnalyzeSources[OtherIndex];
+            if ((Other->Recurring == TRUE) && (Other->Budget->DeadlineCycles != 0U) &&
+                (Source->Budget->DeadlineCycles != 0U) &&
+                (Source->Budget->DeadlineCycles < Other->Budget->DeadlineCycles) && (Source->Level > Other->Level)) {
+                printf("    note: preempted by %s, which has a longer deadline\n", Other->Budget->Name);
+            }
+        }
+    }
+
+    printf("\n  worst-case main stack\n");
+    Depth = NVIC_Analyze_StackDepth();
+    printf("  %-32s %6u of %u bytes\n", "total", (unsigned)Depth, (unsigned)NVIC_ANALYSIS_STACK_BYTES);
+    if (Depth > NVIC_ANALYSIS_STACK_BYTES) {
+        printf("    violation: nested preemption overflows the main stack\n");
+        Violations++;
+    }
+
+    printf("\n%u violation(s)\n", (unsigned)Violations);
+    return (Violations != 0U) ? NVIC_ANALYZE_EXIT_VIOLATION : NVIC_ANALYZE_EXIT_OK;
+}
@@ -0,0 +1,342 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Baseline.c
+ *
+ * Description: Host benchmark and regression driver of the register access cost.
+ *              Runs each public API call once against the register simulator from
+ *              a fixed starting state and prints the loads, stores and bus cycles
+ *              it issued. Given a recorded baseline (Tools/NVIC_Baseline.txt) it
+ *              compares the run against it instead and fails when a call got more
+ *              expensive. See README.md for the build commands.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "NVIC.h"
+#include "NVIC_Sim.h"
+
+#ifndef NVIC_HOST_SIM
+#error "NVIC_Baseline.c runs against the register simulator, build it with NVIC_HOST_SIM"
+#endif
+
+/*******************************************************************************
+ * PREPROCESSOR DEFINITIONS                                                    *
+ *******************************************************************************/
+
+/* Longest API call name in the baseline file */
+#define NVIC_BASELINE_NAME_LENGTH            48U
+
+/* Exit status: costs within the baseline, a call got more expensive, unusable baseline */
+#define NVIC_BASELINE_EXIT_OK                0
+#define NVIC_BASELINE_EXIT_REGRESSION        1
+#define NVIC_BASELINE_EXIT_ERROR             2
+
+/*******************************************************************************
+ * DATA TYPES DDECLERATIONS                                                    *
+ *******************************************************************************/
+
+typedef struct
+{
+    const char *Name;
+    void (*Prepare)(void);      /* Brings the simulator to the call's starting state, not counted */
+    void (*Call)(void);         /* The measured call                                               */
+    void (*Finish)(void);       /* Closes what the call left open, not counted                     */
+} NVIC_BaselineCaseType;
+
+typedef struct
+{
+    char Name[NVIC_BASELINE_NAME_LENGTH];
+    NVIC_SimStatsType Cost;
+    boolean Matched;
+} NVIC_BaselineRecordType;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+/* Stand-in for the startup vector table */
+static const NVIC_HandlerType NVIC_BaselineFlashTable[NVIC_VECTOR_COUNT];
+
+/* Three IRQs over the first two enable words */
+static const NVIC_IRQType NVIC_BaselineList[] = { NVIC_IRQ_UART0, NVIC_IRQ_GPIO_PORTF, NVIC_IRQ_CAN0 };
+#define NVIC_BASELINE_LIST_SIZE              ((uint8)(sizeof(NVIC_BaselineList) / sizeof(NVIC_BaselineList[0])))
+
+static const NVIC_IRQPriorityConfigType NVIC_BaselinePriorityTable[] = {
+    { NVIC_IRQ_GPIO_PORTA, NVIC_PRIORITY_1 },
+    { NVIC_IRQ_GPIO_PORTB, NVIC_PRIORITY_2 },
+    { NVIC_IRQ_GPIO_PORTC, NVIC_PRIORITY_3 },
+    { NVIC_IRQ_GPIO_PORTD, NVIC_PRIORITY_4 },
+    { NVIC_IRQ_UART0, NVIC_PRIORITY_5 },
+    { NVIC_IRQ_GPIO_PORTF, NVIC_PRIORITY_6 },
+    { NVIC_IRQ_CAN0, NVIC_PRIORITY_7 },
+};
+
+static NVIC_IRQPriorityType NVIC_BaselinePriorityArray[NVIC_IRQ_COUNT];
+static NVIC_IRQMaskType NVIC_BaselineMask;
+static NVIC_MaskTokenType NVIC_BaselineToken;
+static NVIC_StateType NVIC_BaselineState;
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+static void NVIC_Baseline_Nothing(void) {
+}
+
+static void NVIC_Baseline_EnableList(void) {
+    NVIC_EnableIRQList(NVIC_BaselineList, NVIC_BASELINE_LIST_SIZE);
+}
+
+static void NVIC_Baseline_SaveAndChange(void) {
+    NVIC_EnableIRQList(NVIC_BaselineList, NVIC_BASELINE_LIST_SIZE);
+    NVIC_SaveState(&NVIC_BaselineState);
+    NVIC_DisableIRQ(NVIC_IRQ_UART0);
+    NVIC_SetPriorityIRQ(NVIC_IRQ_CAN0, NVIC_PRIORITY_3);
+}
+
+static void NVIC_Baseline_MaskSet(void) {
+    NVIC_BaselineToken = NVIC_MaskSet(&NVIC_BaselineMask);
+}
+
+static void NVIC_Baseline_EnableListAndMask(void) {
+    NVIC_Baseline_EnableList();
+    NVIC_Baseline_MaskSet();
+}
+
+static void NVIC_Baseline_EnableIRQ(void) { NVIC_EnableIRQ(NVIC_IRQ_UART0); }
+static void NVIC_Baseline_DisableIRQ(void) { NVIC_DisableIRQ(NVIC_IRQ_UART0); }
+static void NVIC_Baseline_EnableIRQMask(void) { NVIC_EnableIRQMask(&NVIC_BaselineMask); }
+static void NVIC_Baseline_DisableIRQMask(void) { NVIC_DisableIRQMask(&NVIC_BaselineMask); }
+static void NVIC_Baseline_UnmaskSet(void) { NVIC_UnmaskSet(&NVIC_BaselineToken); }
+static void NVIC_Baseline_DisableIRQList(void) { NVIC_DisableIRQList(NVIC_BaselineList, NVIC_BASELINE_LIST_SIZE); }
+static void NVIC_Baseline_SetPending(void) { NVIC_SetPending(&NVIC_BaselineMask); }
+static void NVIC_Baseline_ClearPending(void) { NVIC_ClearPending(&NVIC_BaselineMask); }
+static void NVIC_Baseline_TriggerIRQ(void) { NVIC_TriggerIRQ(NVIC_IRQ_UART0); }
+static void NVIC_Baseline_IsPending(void) { (void)NVIC_IsPending(NVIC_IRQ_UART0); }
+static void NVIC_Baseline_IsActive(void) { (void)NVIC_IsActive(NVIC_IRQ_UART0); }
+static void NVIC_Baseline_IsIRQEnabled(void) { (void)NVIC_IsIRQEnabled(NVIC_IRQ_UART0); }
+static void NVIC_Baseline_SetPriorityIRQ(void) { NVIC_SetPriorityIRQ(NVIC_IRQ_UART0, NVIC_PRIORITY_5); }
+static void NVIC_Baseline_GetPriorityIRQ(void) { (void)NVIC_GetPriorityIRQ(NVIC_IRQ_UART0); }
+static void NVIC_Baseline_SetGroupedPriorityIRQ(void) { NVIC_SetGroupedPriorityIRQ(NVIC_IRQ_UART0, 2U, 0U); }
+
+static void NVIC_Baseline_ApplyPriorityTable(void) {
+    NVIC_ApplyPriorityTable(NVIC_BaselinePriorityTable,
+                            (uint8)(sizeof(NVIC_BaselinePriorityTable) / sizeof(NVIC_BaselinePriorityTable[0])));
+}
+
+static void NVIC_Baseline_ApplyPriorityArray(void) { NVIC_ApplyPriorityArray(NVIC_BaselinePriorityArray); }
+static void NVIC_Baseline_EnableException(void) { NVIC_EnableException(EXCEPTION_MEM_FAULT_TYPE); }
+static void NVIC_Baseline_DisableException(void) { NVIC_DisableException(EXCEPTION_MEM_FAULT_TYPE); }
+
+static void NVIC_Baseline_SetPriorityException(void) {
+    NVIC_SetPriorityException(EXCEPTION_SVC_TYPE, NVIC_EXCEPTION_PRIORITY_2);
+}
+
+static void NVIC_Baseline_GetPriorityException(void) { (void)NVIC_GetPriorityException(EXCEPTION_SVC_TYPE); }
+static void NVIC_Baseline_IsExceptionEnabled(void) { (void)NVIC_IsExceptionEnabled(EXCEPTION_MEM_FAULT_TYPE); }
+static void NVIC_Baseline_SetPriorityGrouping(void) { NVIC_SetPriorityGrouping(NVIC_PRIGROUP_NO_PREEMPT); }
+static void NVIC_Baseline_GetPriorityGrouping(void) { (void)NVIC_GetPriorityGrouping(); }
+static void NVIC_Baseline_InitFromConfig(void) { NVIC_InitFromConfig(); }
+static void NVIC_Baseline_SaveState(void) { NVIC_SaveState(&NVIC_BaselineState); }
+static void NVIC_Baseline_RestoreState(void) { NVIC_RestoreState(&NVIC_BaselineState); }
+static void NVIC_Baseline_RestoreStateChanged(void) { NVIC_RestoreStateChanged(&NVIC_BaselineState); }
+static void NVIC_Baseline_RelocateVectorTable(void) { NVIC_RelocateVectorTable(NVIC_BaselineFlashTable); }
+
+static void NVIC_Baseline_SetExceptionHandler(void) {
+    NVIC_SetExceptionHandler(EXCEPTION_SVC_TYPE, NVIC_Baseline_Nothing);
+}
+
+/* Batched update of three IRQs */
+static void NVIC_Baseline_Update(void) {
+    uint8 Index;
+    NVIC_BeginUpdate();
+    for (Index = 0; Index < NVIC_BASELINE_LIST_SIZE; Index++) {
+        NVIC_EnableIRQ(NVIC_BaselineList[Index]);
+    }
+    NVIC_CommitUpdate();
+}
+
+static const NVIC_BaselineCaseType NVIC_BaselineCases[] = {
+    { "NVIC_EnableIRQ",                NVIC_Baseline_Nothing,              NVIC_Baseline_EnableIRQ,                NVIC_Baseline_Nothing },
+    { "NVIC_DisableIRQ",               NVIC_Baseline_EnableList,           NVIC_Baseline_DisableIRQ,               NVIC_Baseline_Nothing },
+    { "NVIC_EnableIRQMask",            NVIC_Baseline_Nothing,              NVIC_Baseline_EnableIRQMask,            NVIC_Baseline_Nothing },
+    { "NVIC_DisableIRQMask",           NVIC_Baseline_EnableList,           NVIC_Baseline_DisableIRQMask,           NVIC_Baseline_Nothing },
+    { "NVIC_MaskSet",                  NVIC_Baseline_EnableList,           NVIC_Baseline_MaskSet,                  NVIC_Baseline_UnmaskSet },
+    { "NVIC_UnmaskSet",                NVIC_Baseline_EnableListAndMask,    NVIC_Baseline_UnmaskSet,                NVIC_Baseline_Nothing },
+    { "NVIC_EnableIRQList",            NVIC_Baseline_Nothing,              NVIC_Baseline_EnableList,               NVIC_Baseline_Nothing },
+    { "NVIC_DisableIRQList",           NVIC_Baseline_EnableList,           NVIC_Baseline_DisableIRQList,           NVIC_Baseline_Nothing },
+    { "NVIC_BeginUpdate/CommitUpdate", NVIC_Baseline_Nothing,              NVIC_Baseline_Update,                   NVIC_Baseline_Nothing },
+    { "NVIC_SetPending",               NVIC_Baseline_Nothing,              NVIC_Baseline_SetPending,               NVIC_Baseline_Nothing },
+    { "NVIC_ClearPending",             NVIC_Baseline_Nothing,              NVIC_Baseline_ClearPending,             NVIC_Baseline_Nothing },
+    { "NVIC_TriggerIRQ",               NVIC_Baseline_Nothing,              NVIC_Baseline_TriggerIRQ,               NVIC_Baseline_Nothing },
+    { "NVIC_IsPending",                NVIC_Baseline_Nothing,              NVIC_Baseline_IsPending,                NVIC_Baseline_Nothing },
+    { "NVIC_IsActive",                 NVIC_Baseline_Nothing,              NVIC_Baseline_IsActive,                 NVIC_Baseline_Nothing },
+    { "NVIC_IsIRQEnabled",             NVIC_Baseline_Nothing,              NVIC_Baseline_IsIRQEnabled,             NVIC_Baseline_Nothing },
+    { "NVIC_SetPriorityIRQ",           NVIC_Baseline_Nothing,              NVIC_Baseline_SetPriorityIRQ,           NVIC_Baseline_Nothing },
+    { "NVIC_GetPriorityIRQ",           NVIC_Baseline_Nothing,              NVIC_Baseline_GetPriorityIRQ,           NVIC_Baseline_Nothing },
+    { "NVIC_SetGroupedPriorityIRQ",    NVIC_Baseline_Nothing,              NVIC_Baseline_SetGroupedPriorityIRQ,    NVIC_Baseline_Nothing },
+    { "NVIC_ApplyPriorityTable",       NVIC_Baseline_Nothing,              NVIC_Baseline_ApplyPriorityTable,       NVIC_Baseline_Nothing },
+    { "NVIC_ApplyPriorityArray",       NVIC_Baseline_Nothing,              NVIC_Baseline_ApplyPriorityArray,       NVIC_Baseline_Nothing },
+    { "NVIC_EnableException",          NVIC_Baseline_Nothing,              NVIC_Baseline_EnableException,          NVIC_Baseline_Nothing },
+    { "NVIC_DisableException",         NVIC_Baseline_Nothing,              NVIC_Baseline_DisableException,         NVIC_Baseline_Nothing },
+    { "NVIC_IsExceptionEnabled",       NVIC_Baseline_Nothing,              NVIC_Baseline_IsExceptionEnabled,       NVIC_Baseline_Nothing },
+    { "NVIC_SetPriorityException",     NVIC_Baseline_Nothing,              NVIC_Baseline_SetPriorityException,     NVIC_Baseline_Nothing },
+    { "NVIC_GetPriorityException",     NVIC_Baseline_Nothing,              NVIC_Baseline_GetPriorityException,     NVIC_Baseline_Nothing },
+    { "NVIC_SetPriorityGrouping",      NVIC_Baseline_Nothing,              NVIC_Baseline_SetPriorityGrouping,      NVIC_Baseline_Nothing },
+    { "NVIC_GetPriorityGrouping",      NVIC_Baseline_Nothing,              NVIC_Baseline_GetPriorityGrouping,      NVIC_Baseline_Nothing },
+    { "NVIC_InitFromConfig",           NVIC_Baseline_Nothing,              NVIC_Baseline_InitFromConfig,           NVIC_Baseline_Nothing },
+    { "NVIC_SaveState",                NVIC_Baseline_EnableList,           NVIC_Baseline_SaveState,                NVIC_Baseline_Nothing },
+    { "NVIC_RestoreState",             NVIC_Baseline_SaveAndChange,        NVIC_Baseline_RestoreState,             NVIC_Baseline_Nothing },
+    { "NVIC_RestoreStateChanged",      NVIC_Baseline_SaveAndChange,        NVIC_Baseline_RestoreStateChanged,      NVIC_Baseline_Nothing },
+    { "NVIC_RelocateVectorTable",      NVIC_Baseline_Nothing,              NVIC_Baseline_RelocateVectorTable,      NVIC_Baseline_Nothing },
+    { "NVIC_SetExceptionHandler",      NVIC_Baseline_RelocateVectorTable,  NVIC_Baseline_SetExceptionHandler,      NVIC_Baseline_Nothing },
+};
+
+#define NVIC_BASELINE_CASE_COUNT             (sizeof(NVIC_BaselineCases) / sizeof(NVIC_BaselineCases[0]))
+
+static NVIC_BaselineRecordType NVIC_BaselineRecords[NVIC_BASELINE_CASE_COUNT];
+
+/* Runs one case from a freshly reset simulator and returns the accesses of its call */
+static void NVIC_Baseline_Run(const NVIC_BaselineCaseType *Case, NVIC_SimStatsType *Cost) {
+    NVIC_Sim_Reset();
+    NVIC_SyncShadow();
+    Case->Prepare();
+    NVIC_Sim_ClearStats();
+    Case->Call();
+    NVIC_Sim_GetStats(Cost);
+    Case->Finish();
+}
+
+/* Reads "name loads stores cycles" lines, '#' starts a comment line */
+static boolean NVIC_Baseline_Load(const char *Path, uint32 *Record_Count) {
+    FILE *File = fopen(Path, "r");
+    char Line[128];
+    char Name[NVIC_BASELINE_NAME_LENGTH];
+    unsigned Loads;
+    unsigned Stores;
+    unsigned Cycles;
+    uint32 Count = 0;
+
+    if (File == NULL) {
+        printf("cannot open %s\n", Path);
+        return FALSE;
+    }
+    while (fgets(Line, sizeof(Line), File) != NULL) {
+        if ((Line[0] == '#') || (Line[0] == '\n') || (Line[0] == '\r')) {
+            continue;
+        }
+        if ((sscanf(Line, "%47s %u %u %u", Name, &Loads, &Stores, &Cycles) != 4) ||
+            (Count == NVIC_BASELINE_CASE_COUNT)) {
+            printf("%s: bad line: %s", Path, Line);
+            (void)fclose(File);
+            return FALSE;
+        }
+        (void)strcpy(NVIC_BaselineRecords[Count].Name, Name);
+        NVIC_BaselineRecords[Count].Cost.Loads = Loads;
+        NVIC_BaselineRecords[Count].Cost.Stores = Stores;
+        NVIC_BaselineRecords[Count].Cost.Cycles = Cycles;
+        NVIC_BaselineRecords[Count].Matched = FALSE;
+        Count++;
+    }
+    (void)fclose(File);
+    *Record_Count = Count;
+    return TRUE;
+}
+
+static NVIC_BaselineRecordType *NVIC_Baseline_Find(const char *Name, uint32 Record_Count) {
+    uint32 Index;
+    for (Index = 0; Index < Record_Count; Index++) {
+        if (strcmp(NVIC_BaselineRecords[Index].Name, Name) == 0) {
+            return &NVIC_BaselineRecords[Index];
+        }
+    }
+    return NULL;
+}
+
+/* Prints the costs in the baseline file format */
+static int NVIC_Baseline_Print(void) {
+    NVIC_SimStatsType Cost;
+    uint32 Index;
+
+    printf("# Register accesses of each API call, NVIC_Cfg.h with NVIC_SHADOW_ENABLE %u\n", (unsigned)NVIC_SHADOW_ENABLE);
+    printf("# %-30s %6s %6s %6s\n", "call", "loads", "stores", "cycles");
+    for (Index = 0; Index < NVIC_BASELINE_CASE_COUNT; Index++) {
+        NVIC_Baseline_Run(&NVIC_BaselineCases[Index], &Cost);
+        printf("  %-30s %6u %6u %6u\n", NVIC_BaselineCases[Index].Name,
+               (unsigned)Cost.Loads, (unsigned)Cost.Stores, (unsigned)Cost.Cycles);
+    }
+    return NVIC_BASELINE_EXIT_OK;
+}
+
+/* Compares every call with its recorded cost, a higher count in any column is a regression */
+static int NVIC_Baseline_Compare(const char *Path) {
+    NVIC_SimStatsType Cost;
+    NVIC_BaselineRecordType *Record;
+    uint32 Record_Count;
+    uint32 Index;
+    int Status = NVIC_BASELINE_EXIT_OK;
+
+    if (NVIC_Baseline_Load(Path, &Record_Count) == FALSE) {
+        return NVIC_BASELINE_EXIT_ERROR;
+    }
+    printf("  %-30s %13s %13s %13s\n", "call", "loads", "stores", "cycles");
+    for (Index = 0; Index < NVIC_BASELINE_CASE_COUNT; Index++) {
+        Record = NVIC_Baseline_Find(NVIC_BaselineCases[Index].Name, Record_Count);
+        if (Record == NULL) {
+            printf("  %-30s not in the baseline\n", NVIC_BaselineCases[Index].Name);
+            Status = NVIC_BASELINE_EXIT_ERROR;
+            continue;
+        }
+        Record->Matched = TRUE;
+        NVIC_Baseline_Run(&NVIC_BaselineCases[Index], &Cost);
+        printf("  %-30s %6u (%4u) %6u (%4u) %6u (%4u)", NVIC_BaselineCases[Index].Name,
+               (unsigned)Cost.Loads, (unsigned)Record->Cost.Loads, (unsigned)Cost.Stores,
+               (unsigned)Record->Cost.Stores, (unsigned)Cost.Cycles, (unsigned)Record->Cost.Cycles);
+        if ((Cost.Loads > Record->Cost.Loads) || (Cost.Stores > Record->Cost.Stores) ||
+            (Cost.Cycles > Record->Cost.Cycles)) {
+            printf("  REGRESSION\n");
+            if (Status == NVIC_BASELINE_EXIT_OK) {
+                Status = NVIC_BASELINE_EXIT_REGRESSION;
+            }
+        } else if ((Cost.Loads < Record->Cost.Loads) || (Cost.Stores < Record->Cost.Stores) ||
+                   (Cost.Cycles < Record->Cost.Cycles)) {
+            printf("  improved\n");
+        } else {
+            printf("\n");
+        }
+    }
+    for (Index = 0; Index < Record_Count; Index++) {
+        if (NVIC_BaselineRecords[Index].Matched == FALSE) {
+            printf("  %-30s in the baseline but not measured\n", NVIC_BaselineRecords[Index].Name);
+            Status = NVIC_BASELINE_EXIT_ERROR;
+        }
+    }
+    return Status;
+}
+
+/* nvic_baseline                 prints the cost of each call
+ * nvic_baseline <baseline file>  exits 0 within the baseline, 1 on a regression, 2 if the file does not match */
+int main(int argc, char *argv[]) {
+    uint32 Index;
+
+    for (Index = 0; Index < NVIC_IRQ_COUNT; Index++) {
+        NVIC_BaselinePriorityArray[Index] = (NVIC_IRQPriorityType)(Index % (1UL << NVIC_PRIORITY_BITS));
+    }
+    for (Index = 0; Index < NVIC_BASELINE_LIST_SIZE; Index++) {
+        NVIC_IRQ_MASK_ADD(NVIC_BaselineMask, NVIC_BaselineList[Index]);
+    }
+    if (argc > 2) {
+        printf("usage: %s [baseline file]\n", argv[0]);
+        return NVIC_BASELINE_EXIT_ERROR;
+    }
+    return (argc == 2) ? NVIC_Baseline_Compare(argv[1]) : NVIC_Baseline_Print();
+}
@@ -0,0 +1,108 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_FpuBench.c
+ *
+ * Description: Driver program of NVIC_Fpu_Benchmark. Brings the interrupt
+ *              configuration of NVIC_Cfg.h up, then measures the exception entry
+ *              and exit cost of each FPU stacking mode. Built with NVIC_HOST_SIM it
+ *              runs against the simulator cost model and prints the table; on the
+ *              board it leaves the results in NVIC_FpuBenchResults and stops at a
+ *              breakpoint for the debugger to read them. See README.md for the
+ *              build commands.
+ *
+ * Author: Mohamed Hisham
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * INCLUSIONS                                                                  *
+ *******************************************************************************/
+
+#include "NVIC.h"
+#include "NVIC_Fpu.h"
+#include "NVIC_Regs.h"
+
+#ifdef NVIC_HOST_SIM
+#include <stdio.h>
+#include "NVIC_Sim.h"
+#endif
+
+#if !NVIC_FPU_BENCH_ENABLE
+#error "NVIC_FpuBench.c needs NVIC_FPU_BENCH_ENABLE set to 1"
+#endif
+
+/*******************************************************************************
+ * GLOBAL VARIABLES                                                            *
+ *******************************************************************************/
+
+/* Results of the last run and its status: 0 running, 1 done, 2 FPU not enabled */
+volatile NVIC_FpuBenchResultType NVIC_FpuBenchResults[NVIC_FPU_BENCH_MODE_COUNT];
+volatile uint32 NVIC_FpuBenchStatus;
+
+#ifdef NVIC_HOST_SIM
+/* Stand-in for the startup vector table */
+static const NVIC_HandlerType NVIC_FpuBenchFlashTable[NVIC_VECTOR_COUNT];
+
+/* Name of each NVIC_FpuStackingType */
+static const char *const NVIC_FpuBenchModeNames[] = { "none", "full", "lazy" };
+#endif
+
+/*******************************************************************************
+ * FUNCTION DEFINITIONS                                                        *
+ *******************************************************************************/
+
+int main(void) {
+    NVIC_FpuBenchResultType Results[NVIC_FPU_BENCH_MODE_COUNT];
+    NVIC_IRQMaskType Unsafe;
+    boolean Ran;
+    uint32 Index;
+
+#ifdef NVIC_HOST_SIM
+    NVIC_Sim_Reset();
+    NVIC_RelocateVectorTable(NVIC_FpuBenchFlashTable);
+#else
+    NVIC_RelocateVectorTable((const NVIC_HandlerType *)NVIC_READ32(NVIC_SYSTEM_VTABLE_ADDR));
+#endif
+    /* CP10/CP11 full access: the benchmark thread owns FP state */
+    NVIC_WRITE32(NVIC_SYSTEM_CPACR_ADDR, NVIC_READ32(NVIC_SYSTEM_CPACR_ADDR) | CPACR_FPU_ACCESS_MASK);
+    NVIC_DSB();
+    NVIC_ISB();
+
+    NVIC_InitFromConfig();
+    (void)NVIC_Fpu_Init();
+    Enable_Exceptions();
+
+    Ran = NVIC_Fpu_Benchmark(Results);
+    for (Index = 0; Index < NVIC_FPU_BENCH_MODE_COUNT; Index++) {
+        NVIC_FpuBenchResults[Index] = Results[Index];
+    }
+    NVIC_FpuBenchStatus = (Ran == TRUE) ? 1U : 2U;
+
+#ifdef NVIC_HOST_SIM
+    if (Ran == FALSE) {
+        printf("FPU not enabled in CPACR\n");
+        return 1;
+    }
+    printf("FPU stacking benchmark, configured mode %s, %s enabled IRQs not FPU-free\n",
+           NVIC_FpuBenchModeNames[NVIC_FPU_STACKING], (NVIC_Fpu_GetUnsafeIRQs(&Unsafe) == TRUE) ? "no" : "some");
+    printf("  %-6s %7s %7s %10s %10s\n", "mode", "entry", "exit", "fpu entry", "fpu exit");
+    for (Index = 0; Index < NVIC_FPU_BENCH_MODE_COUNT; Index++) {
+        if (Results[Index].Valid == FALSE) {
+            printf("  %-6s refused\n", NVIC_FpuBenchModeNames[Results[Index].Mode]);
+            continue;
+        }
+        printf("  %-6s %7u %7u %10u %10u\n", NVIC_FpuBenchModeNames[Results[Index].Mode],
+               (unsigned)Results[Index].EntryCycles, (unsigned)Results[Index].ExitCycles,
+               (unsigned)Results[Index].FpuEntryCycles, (unsigned)Results[Index].FpuExitCycles);
+    }
+    return 0;
+#else
+    (void)Unsafe;
+    /* Inspect NVIC_FpuBenchResults from the debugger */
+    __asm volatile ("BKPT #0");
+    for (;;) {
+    }
+#endif
+}